@@ -0,0 +1,304 @@
+/**
+ * @file Benchmark.ino
+ * @author Curt Henrichs
+ * @brief Polip Client Microbenchmarks
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Times the CPU hot paths of the library without any network traffic:
+ * request packing, tag computation, hex conversion, RPC status parsing, and
+ * RPC bookkeeping. Each case runs over parameterized sizes and prints one JSON
+ * object per line on Serial so results can be collected and diffed by script.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <polip-client.h>
+#include <polip-device-internal.hpp>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define BENCH_DOC_SIZE                              (8192)
+#define BENCH_BUFFER_SIZE                           (4096)
+#define BENCH_ITERATIONS                            (50)
+#define BENCH_FAST_ITERATIONS                       (1000)
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+static const uint8_t KEY[] = "benchmark-key-0123456789abcdef";
+static const char* TIMESTAMP = "2022-10-20T00:00:00Z";
+
+static const unsigned int PAYLOAD_FIELDS[] = {4, 16, 64, 256};
+static const unsigned int BATCH_SIZES[] = {1, 8, 32};
+static const unsigned int ACTIVE_RPCS[] = {1, 4, 16};
+static const unsigned int INCOMING_RPCS[] = {0, 4, 16};
+
+static char buffer[BENCH_BUFFER_SIZE];
+static DynamicJsonDocument doc(BENCH_DOC_SIZE);
+static polip_device_t dev;
+static polip_rpc_workflow_t rpcWk;
+static polip_tag_context_t tagCtx;
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _report(const char* bench, unsigned int size, unsigned int extra, 
+        unsigned int iters, unsigned long total_us);
+static void _buildPayload(unsigned int fields);
+static void _resetRPCs(unsigned int maxRPCs, unsigned int active);
+static void _buildRPCList(unsigned int active, unsigned int incoming);
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params);
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc);
+
+static void _benchPackRequest();
+static void _benchComputeTag();
+static void _benchTagBatch();
+static void _benchArray2String();
+static void _benchStatusStr2Enum();
+static void _benchPollEvent();
+static void _benchFreeRPC();
+
+//==============================================================================
+//  Setup / Loop
+//==============================================================================
+
+void setup() {
+    Serial.begin(115200);
+    delay(100);
+
+    dev.serialStr = "bench-serial";
+    dev.keyStr = KEY;
+    dev.keyStrLen = sizeof(KEY) - 1;
+    dev.hardwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+    dev.firmwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+    dev.debugMode = false;
+    dev.buffer = buffer;
+    dev.bufferLen = BENCH_BUFFER_SIZE;
+
+    POLIP_RPC_WORKFLOW_ASSIGN_CORE_HOOKS(&rpcWk, _acceptRPC, _cancelRPC);
+
+    _benchPackRequest();
+    _benchComputeTag();
+    _benchTagBatch();
+    _benchArray2String();
+    _benchStatusStr2Enum();
+    _benchPollEvent();
+    _benchFreeRPC();
+
+    Serial.println(F("{\"done\":true}"));
+}
+
+void loop() {
+    delay(1000);
+}
+
+//==============================================================================
+//  Benchmark Cases
+//==============================================================================
+
+static void _benchPackRequest() {
+    for (unsigned int fields : PAYLOAD_FIELDS) {
+        unsigned long total = 0;
+        for (unsigned int i = 0; i < BENCH_ITERATIONS; i++) {
+            _buildPayload(fields);
+            unsigned long start = micros();
+            _packRequest(&dev, doc, TIMESTAMP, i, false, true);
+            total += micros() - start;
+        }
+        _report("packRequest", fields, 0, BENCH_ITERATIONS, total);
+        yield();
+    }
+}
+
+static void _benchComputeTag() {
+    for (int cached = 0; cached < 2; cached++) {
+        dev.tagContext = (cached) ? &tagCtx : NULL;
+        for (unsigned int fields : PAYLOAD_FIELDS) {
+            unsigned long total = 0;
+            for (unsigned int i = 0; i < BENCH_ITERATIONS; i++) {
+                _buildPayload(fields);
+                _packRequest(&dev, doc, TIMESTAMP, i, false, true);
+                doc["tag"] = "0";
+                unsigned long start = micros();
+                _computeTag(&dev, doc);
+                total += micros() - start;
+            }
+            _report((cached) ? "computeTagCached" : "computeTag", fields, measureJson(doc), BENCH_ITERATIONS, total);
+            yield();
+        }
+    }
+    dev.tagContext = NULL;
+}
+
+static void _benchTagBatch() {
+    static polip_tag_job_t jobs[32];
+
+    // Typical small request, same message signed for each job
+    _buildPayload(16);
+    _packRequest(&dev, doc, TIMESTAMP, 0, false, true);
+    size_t len = serializeJson(doc, buffer, BENCH_BUFFER_SIZE);
+
+    dev.tagContext = &tagCtx;
+    for (unsigned int batch : BATCH_SIZES) {
+        for (unsigned int j = 0; j < batch; j++) {
+            jobs[j].dev = &dev;
+            jobs[j].msg = buffer;
+            jobs[j].len = len;
+        }
+
+        unsigned long start = micros();
+        for (unsigned int i = 0; i < BENCH_ITERATIONS; i++) {
+            polip_tag_compute_batch(jobs, batch);
+        }
+        _report("tagBatch", batch, len, BENCH_ITERATIONS * batch, micros() - start);
+        yield();
+    }
+    dev.tagContext = NULL;
+}
+
+static void _benchArray2String() {
+    uint8_t bytes[SHA256HMAC_SIZE];
+    char str[SHA256HMAC_SIZE*2 + 1];
+    for (unsigned int i = 0; i < SHA256HMAC_SIZE; i++) {
+        bytes[i] = (uint8_t)(i * 37);
+    }
+
+    unsigned long start = micros();
+    for (unsigned int i = 0; i < BENCH_FAST_ITERATIONS; i++) {
+        bytes[0] = (uint8_t)i;
+        _array2string(bytes, SHA256HMAC_SIZE, str);
+    }
+    _report("array2string", SHA256HMAC_SIZE, str[0], BENCH_FAST_ITERATIONS, micros() - start);
+}
+
+static void _benchStatusStr2Enum() {
+    static const char* statuses[] = {
+        POLIP_RPC_STATUS_PENDING_STR,
+        POLIP_RPC_STATUS_SUCCESS_STR,
+        POLIP_RPC_STATUS_FAILURE_STR,
+        POLIP_RPC_STATUS_REJECTED_STR,
+        POLIP_RPC_STATUS_ACKNOWLEDGED_STR,
+        POLIP_RPC_STATUS_CANCELED_STR,
+        "unknown"
+    };
+
+    for (unsigned int s = 0; s < sizeof(statuses) / sizeof(statuses[0]); s++) {
+        unsigned int sink = 0;
+        unsigned long start = micros();
+        for (unsigned int i = 0; i < BENCH_FAST_ITERATIONS; i++) {
+            sink += polip_rpc_status_str2enum(statuses[s]);
+        }
+        _report("rpcStatusStr2Enum", s, sink, BENCH_FAST_ITERATIONS, micros() - start);
+    }
+}
+
+static void _benchPollEvent() {
+    for (unsigned int active : ACTIVE_RPCS) {
+        for (unsigned int incoming : INCOMING_RPCS) {
+            unsigned long total = 0;
+            for (unsigned int i = 0; i < BENCH_ITERATIONS; i++) {
+                _resetRPCs(active + incoming, active);
+                _buildRPCList(active, incoming);
+                unsigned long start = micros();
+                polip_rpc_workflow_poll_event(&rpcWk, &dev, doc, TIMESTAMP);
+                total += micros() - start;
+            }
+            _report("rpcPollEvent", active, incoming, BENCH_ITERATIONS, total);
+            yield();
+        }
+    }
+}
+
+static void _benchFreeRPC() {
+    for (unsigned int active : ACTIVE_RPCS) {
+        unsigned long total = 0;
+        for (unsigned int i = 0; i < BENCH_ITERATIONS; i++) {
+            _resetRPCs(active, active);
+
+            // Oldest entry sits at end of active list, worst case search
+            polip_rpc_t* last = rpcWk.state._activePtr;
+            while (last->_nextPtr != NULL) {
+                last = last->_nextPtr;
+            }
+
+            unsigned long start = micros();
+            polip_rpc_workflow_free_rpc(&rpcWk, last, &dev);
+            total += micros() - start;
+        }
+        _report("rpcFree", active, 0, BENCH_ITERATIONS, total);
+        yield();
+    }
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _report(const char* bench, unsigned int size, unsigned int extra, 
+        unsigned int iters, unsigned long total_us) {
+    StaticJsonDocument<192> out;
+    out["bench"] = bench;
+    out["size"] = size;
+    out["extra"] = extra;
+    out["iters"] = iters;
+    out["total_us"] = total_us;
+    out["ns_per_op"] = (float)total_us * 1000.0f / iters;
+    serializeJson(out, Serial);
+    Serial.println();
+}
+
+static void _buildPayload(unsigned int fields) {
+    char key[12];
+    doc.clear();
+    JsonObject state = doc.createNestedObject("state");
+    for (unsigned int i = 0; i < fields; i++) {
+        sprintf(key, "k%u", i);
+        state[key] = i * 3;
+    }
+}
+
+static void _resetRPCs(unsigned int maxRPCs, unsigned int active) {
+    char uuid[POLIP_RPC_UUID_BUFFER_SIZE];
+    JsonObject params;
+
+    polip_rpc_workflow_teardown(&rpcWk);
+    rpcWk.params.maxActiveRPCs = maxRPCs;
+    polip_rpc_workflow_initialize(&rpcWk);
+
+    for (unsigned int i = 0; i < active; i++) {
+        sprintf(uuid, "rpc-%u", i);
+        polip_rpc_workflow_new_rpc(&rpcWk, POLIP_RPC_STATUS_ACKNOWLEDGED, uuid, "bench", params, &dev);
+    }
+}
+
+static void _buildRPCList(unsigned int active, unsigned int incoming) {
+    char uuid[POLIP_RPC_UUID_BUFFER_SIZE];
+    doc.clear();
+    JsonArray rpcArr = doc.createNestedArray("rpc");
+
+    // Known RPCs first, then new pending RPCs to accept
+    for (unsigned int i = 0; i < active + incoming; i++) {
+        sprintf(uuid, "rpc-%u", i);
+        JsonObject rpcObj = rpcArr.createNestedObject();
+        rpcObj["uuid"] = uuid;
+        rpcObj["type"] = "bench";
+        rpcObj["status"] = (i < active) ? POLIP_RPC_STATUS_ACKNOWLEDGED_STR : POLIP_RPC_STATUS_PENDING_STR;
+        rpcObj.createNestedObject("parameters");
+    }
+}
+
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params) {
+    return true;
+}
+
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc) {
+    return true;
+}
\ No newline at end of file
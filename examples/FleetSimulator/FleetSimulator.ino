@@ -0,0 +1,364 @@
+/**
+ * @file FleetSimulator.ino
+ * @author Curt Henrichs
+ * @brief Polip Client Fleet Load Simulator
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Runs many virtual devices from one board through the real workflow code,
+ * each with its own serial, key, value and RPC pool, against a mock or staging
+ * ingest server. Aggregate request rate, update latency distribution and
+ * client CPU time per device are printed as one JSON object per report.
+ * 
+ * Run extras/mock-ingest/mock_ingest.py on a host and point the library at
+ * it with a build flag, for example
+ *   -DPOLIP_DEVICE_INGEST_SERVER_URL=\"http://192.168.1.10:3021\"
+ * and enable POLIP_LATENCY_STATS to split client CPU time from network time.
+ * Keys are derived from FLEET_KEY_SEED and the serial, the same way the mock
+ * server derives them, so tags are computed and checked as on a real device.
+ * 
+ * The library only builds for the ESP8266, so the fleet runs on boards rather
+ * than a host process. One board holds a few devices; run several boards
+ * against the same mock server to reach larger fleets.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <ESP8266WiFi.h>
+#include <polip-client.h>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#ifndef WIFI_SSID
+#define WIFI_SSID                                   "ssid"
+#endif
+
+#ifndef WIFI_PASSWORD
+#define WIFI_PASSWORD                               "password"
+#endif
+
+//! Virtual devices on this board, bounded by RAM for RPC pools and metrics
+#ifndef FLEET_SIZE
+#define FLEET_SIZE                                  (8)
+#endif
+
+//! Serials are FLEET_SERIAL_PREFIX followed by device index
+#ifndef FLEET_SERIAL_PREFIX
+#define FLEET_SERIAL_PREFIX                         "sim-"
+#endif
+
+//! Skips response tag check, leave false so client CPU includes HMAC
+#ifndef FLEET_SKIP_TAG_CHECK
+#define FLEET_SKIP_TAG_CHECK                        (false)
+#endif
+
+//! Keys are SHA-256(seed + serial), must match mock server --key-seed
+#ifndef FLEET_KEY_SEED
+#define FLEET_KEY_SEED                              "polip-fleet"
+#endif
+
+#define FLEET_KEY_BUFFER_SIZE                       (SHA256_SIZE)
+#define FLEET_SERIAL_BUFFER_SIZE                    (16)
+#define FLEET_DOC_SIZE                              (2048)
+#define FLEET_BUFFER_SIZE                           (2048)
+#define FLEET_MAX_RPCS                              (2)
+#define FLEET_POLL_PERIOD_MS                        (1000)
+#define FLEET_SENSE_PERIOD_MS                       (5000)
+#define FLEET_STATE_CHANGE_PERCENT                  (5)
+#define FLEET_REPORT_PERIOD_MS                      (10000)
+
+//! Upper bounds of update latency histogram buckets in us (POLIP_STATS_HIST_BUCKETS - 1)
+#define FLEET_UPDATE_HIST_BOUNDS                    {1000UL, 10000UL, 50000UL, 100000UL, 250000UL, 500000UL, 1000000UL}
+
+//==============================================================================
+//  Data Structure Declaration
+//==============================================================================
+
+typedef struct _fleet_member {
+    char serial[FLEET_SERIAL_BUFFER_SIZE];
+    uint8_t key[FLEET_KEY_BUFFER_SIZE];
+    polip_device_t device;
+    polip_workflow_t workflow;
+    polip_rpc_workflow_t rpcWorkflow;
+    polip_rpc_t* accepted[FLEET_MAX_RPCS]; //! Accepted RPCs, completed once acknowledged
+    polip_workflow_metrics_t metrics;
+#if POLIP_LATENCY_STATS
+    polip_latency_stats_t latency;
+#endif
+    int state;
+} fleet_member_t;
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+static const char* TIMESTAMP = "2022-10-20T00:00:00Z";
+static const uint32_t UPDATE_HIST_BOUNDS[POLIP_STATS_HIST_BUCKETS - 1] = FLEET_UPDATE_HIST_BOUNDS;
+
+static fleet_member_t fleet[FLEET_SIZE];
+static char buffer[FLEET_BUFFER_SIZE];
+static StaticJsonDocument<FLEET_DOC_SIZE> doc;
+
+static polip_stat_t updateStat;
+static polip_histogram_t updateHistogram;
+static unsigned long reportTimer = 0;
+static uint32_t lastRequests = 0;
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static fleet_member_t* _member(polip_device_t* dev);
+static void _report(unsigned long currentTime_ms);
+static uint32_t _countRequests();
+static void _pushStateSetup(polip_device_t* dev, JsonDocument& doc);
+static void _pollStateResp(polip_device_t* dev, JsonDocument& doc);
+static void _pushSenseSetup(polip_device_t* dev, JsonDocument& doc);
+static void _workflowError(polip_device_t* dev, JsonDocument& doc, 
+        polip_workflow_source_t source, polip_ret_code_t error);
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params);
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc);
+static void _freeRPC(polip_device_t* dev, polip_rpc_t* rpc);
+static void _completeRPCs(fleet_member_t* m);
+
+//==============================================================================
+//  Setup / Loop
+//==============================================================================
+
+void setup() {
+    Serial.begin(115200);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    while (WiFi.status() != WL_CONNECTED) {
+        delay(500);
+    }
+
+    POLIP_BLOCK_AWAIT_SERVER_OK();
+
+    unsigned long now = millis();
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        fleet_member_t* m = &fleet[i];
+
+        snprintf(m->serial, FLEET_SERIAL_BUFFER_SIZE, FLEET_SERIAL_PREFIX "%u", i);
+        SHA256 keyHash;
+        keyHash.doUpdate(FLEET_KEY_SEED);
+        keyHash.doUpdate(m->serial);
+        keyHash.doFinal(m->key);
+
+        m->device.serialStr = m->serial;
+        m->device.keyStr = m->key;
+        m->device.keyStrLen = FLEET_KEY_BUFFER_SIZE;
+        m->device.hardwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+        m->device.firmwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+        m->device.skipTagCheck = FLEET_SKIP_TAG_CHECK;
+        m->device.debugMode = false;
+        m->device.buffer = buffer;
+        m->device.bufferLen = FLEET_BUFFER_SIZE;
+#if POLIP_LATENCY_STATS
+        m->device.latencyStats = &m->latency;
+#endif
+
+        m->rpcWorkflow.params.maxActiveRPCs = FLEET_MAX_RPCS;
+        POLIP_RPC_WORKFLOW_ASSIGN_CORE_HOOKS(&m->rpcWorkflow, _acceptRPC, _cancelRPC);
+        m->rpcWorkflow.hooks.freeRPC = _freeRPC;
+
+        m->workflow.device = &m->device;
+        m->workflow.rpcWorkflow = &m->rpcWorkflow;
+        m->workflow.metrics = &m->metrics;
+        m->workflow.params.pushSensePeriodic = true;
+        m->workflow.params.pollStateTimeThreshold = FLEET_POLL_PERIOD_MS;
+        m->workflow.params.pushSenseTimeThreshold = FLEET_SENSE_PERIOD_MS;
+        m->workflow.hooks.pushStateSetupCb = _pushStateSetup;
+        m->workflow.hooks.pollStateRespCb = _pollStateResp;
+        m->workflow.hooks.pushSenseSetupCb = _pushSenseSetup;
+        m->workflow.hooks.workflowErrorCb = _workflowError;
+
+        // Stagger timers so the fleet does not fire in lock-step
+        polip_workflow_initialize(&m->workflow, now - random(FLEET_POLL_PERIOD_MS));
+    }
+
+    reportTimer = millis();
+}
+
+void loop() {
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        fleet_member_t* m = &fleet[i];
+
+        if (random(100) < FLEET_STATE_CHANGE_PERCENT) {
+            m->state++;
+            POLIP_WORKFLOW_STATE_CHANGED(&m->workflow);
+        }
+
+        _completeRPCs(m);
+
+        unsigned long start = micros();
+        polip_workflow_periodic_update(&m->workflow, doc, TIMESTAMP, millis());
+        unsigned long elapsed = micros() - start;
+
+        polip_stat_record(&updateStat, elapsed);
+        polip_histogram_record(&updateHistogram, UPDATE_HIST_BOUNDS, elapsed);
+
+        if (POLIP_WORKFLOW_IN_ERROR(&m->workflow)) {
+            POLIP_WORKFLOW_ACK_ERROR(&m->workflow);
+        }
+        yield();
+    }
+
+    unsigned long now = millis();
+    if ((now - reportTimer) >= FLEET_REPORT_PERIOD_MS) {
+        _report(now);
+        reportTimer = now;
+    }
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static fleet_member_t* _member(polip_device_t* dev) {
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        if (&fleet[i].device == dev) {
+            return &fleet[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t _countRequests() {
+    uint32_t total = 0;
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        for (unsigned int s = 0; s < _POLIP_WORKFLOW_SOURCE_COUNT; s++) {
+            for (unsigned int c = 0; c < _POLIP_RET_CODE_COUNT; c++) {
+                total += fleet[i].metrics.events[s][c];
+            }
+        }
+    }
+    return total;
+}
+
+static void _report(unsigned long currentTime_ms) {
+    StaticJsonDocument<512> out;
+    uint32_t requests = _countRequests();
+    uint32_t errors = 0;
+    uint32_t resyncs = 0;
+
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        for (unsigned int s = 0; s < _POLIP_WORKFLOW_SOURCE_COUNT; s++) {
+            for (unsigned int c = 0; c < _POLIP_RET_CODE_COUNT; c++) {
+                if (c != POLIP_OK && c != POLIP_OK_NOT_MODIFIED) {
+                    errors += fleet[i].metrics.events[s][c];
+                }
+            }
+        }
+        resyncs += fleet[i].device.valueResyncs;
+    }
+
+    out["devices"] = FLEET_SIZE;
+    out["requests"] = requests;
+    out["errors"] = errors;
+    out["resyncs"] = resyncs;
+    out["req_per_s"] = (float)(requests - lastRequests) * 1000.0f / FLEET_REPORT_PERIOD_MS;
+    out["heap"] = ESP.getFreeHeap();
+
+    JsonArray update = out.createNestedArray("update_us");
+    update.add(updateStat.count);
+    update.add(updateStat.min);
+    update.add(polip_stat_mean(&updateStat));
+    update.add(updateStat.max);
+
+    JsonArray hist = out.createNestedArray("update_hist");
+    for (unsigned int b = 0; b < POLIP_STATS_HIST_BUCKETS; b++) {
+        hist.add(updateHistogram.counts[b]);
+    }
+
+#if POLIP_LATENCY_STATS
+    // Client CPU is every phase except waiting on and reading from the network
+    uint64_t cpu = 0;
+    uint64_t network = 0;
+    for (unsigned int i = 0; i < FLEET_SIZE; i++) {
+        for (unsigned int e = 0; e < _POLIP_ENDPOINT_COUNT; e++) {
+            const polip_latency_endpoint_t* ep = &fleet[i].latency.endpoints[e];
+            for (unsigned int p = 0; p < _POLIP_LATENCY_PHASE_COUNT; p++) {
+                if (p == POLIP_LATENCY_PHASE_EXCHANGE || p == POLIP_LATENCY_PHASE_RECEIVE) {
+                    network += ep->phases[p].sum;
+                } else {
+                    cpu += ep->phases[p].sum;
+                }
+            }
+        }
+    }
+    out["cpu_us_per_device"] = (uint32_t)(cpu / FLEET_SIZE);
+    out["network_us_per_device"] = (uint32_t)(network / FLEET_SIZE);
+#endif
+
+    serializeJson(out, Serial);
+    Serial.println();
+
+    lastRequests = requests;
+}
+
+static void _pushStateSetup(polip_device_t* dev, JsonDocument& doc) {
+    doc["state"]["level"] = _member(dev)->state;
+}
+
+static void _pollStateResp(polip_device_t* dev, JsonDocument& doc) {
+    if (doc.containsKey("state")) {
+        _member(dev)->state = doc["state"]["level"] | _member(dev)->state;
+    }
+}
+
+static void _pushSenseSetup(polip_device_t* dev, JsonDocument& doc) {
+    JsonObject sense = doc.createNestedObject("sense");
+    sense["temperature"] = 20 + random(100) / 10.0f;
+    sense["humidity"] = random(100);
+    sense["uptime"] = millis();
+}
+
+static void _workflowError(polip_device_t* dev, JsonDocument& doc, 
+        polip_workflow_source_t source, polip_ret_code_t error) {
+    // Counted by workflow metrics, nothing else to do
+}
+
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params) {
+    // Workflow sets acknowledged after this returns, so completion is queued
+    fleet_member_t* m = _member(dev);
+    for (unsigned int i = 0; i < FLEET_MAX_RPCS; i++) {
+        if (m->accepted[i] == NULL || m->accepted[i] == rpc) {
+            m->accepted[i] = rpc;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc) {
+    _freeRPC(dev, rpc);
+    return true;
+}
+
+static void _freeRPC(polip_device_t* dev, polip_rpc_t* rpc) {
+    fleet_member_t* m = _member(dev);
+    for (unsigned int i = 0; i < FLEET_MAX_RPCS; i++) {
+        if (m->accepted[i] == rpc) {
+            m->accepted[i] = NULL;
+        }
+    }
+}
+
+static void _completeRPCs(fleet_member_t* m) {
+    // Simulated work finishes once the acknowledge has gone out
+    for (unsigned int i = 0; i < FLEET_MAX_RPCS; i++) {
+        polip_rpc_t* rpc = m->accepted[i];
+        if (rpc != NULL && rpc->status == POLIP_RPC_STATUS_ACKNOWLEDGED 
+                && rpc->_nextStatus == POLIP_RPC_STATUS_ACKNOWLEDGED) {
+            POLIP_RPC_WORKFLOW_RPC_SUCCEEDED(&m->rpcWorkflow, rpc);
+            m->accepted[i] = NULL;
+        }
+    }
+}
\ No newline at end of file
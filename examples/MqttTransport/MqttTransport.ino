@@ -0,0 +1,184 @@
+/**
+ * @file MqttTransport.ino
+ * @author Curt Henrichs
+ * @brief Polip Client MQTT Transport Example
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Runs the standard workflow with requests carried over MQTT instead of HTTP,
+ * and RPCs pushed by the server as soon as they are created.
+ * 
+ * For a local test, run a broker (e.g. mosquitto) and the bridge in
+ * extras/mqtt-bridge, which forwards request topics to the ingest server and
+ * publishes its replies:
+ *   mosquitto -v
+ *   python3 extras/mqtt-bridge/mqtt_bridge.py --broker localhost --server http://localhost:3021
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <ESP8266WiFi.h>
+#include <PubSubClient.h>
+#include <polip-client.h>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#ifndef WIFI_SSID
+#define WIFI_SSID                                   "ssid"
+#endif
+
+#ifndef WIFI_PASSWORD
+#define WIFI_PASSWORD                               "password"
+#endif
+
+#ifndef MQTT_BROKER_HOST
+#define MQTT_BROKER_HOST                            "192.168.1.10"
+#endif
+
+#ifndef MQTT_BROKER_PORT
+#define MQTT_BROKER_PORT                            (1883)
+#endif
+
+#define MQTT_RECONNECT_PERIOD_MS                    (5000)
+#define DOC_SIZE                                    (1024)
+#define BUFFER_SIZE                                 (1024)
+#define MQTT_PACKET_SIZE                            (BUFFER_SIZE + POLIP_MQTT_TOPIC_BUFFER_SIZE)
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+static const char* TIMESTAMP = "2022-10-20T00:00:00Z";
+static const char* SERIAL_STR = "mqtt-0";
+static const uint8_t KEY[] = "0123456789abcdef";
+
+static WiFiClient wifiClient;
+static PubSubClient mqttClient(wifiClient);
+
+static char buffer[BUFFER_SIZE];
+static char rxBuffer[BUFFER_SIZE];
+static StaticJsonDocument<DOC_SIZE> doc;
+
+static polip_device_t device;
+static polip_workflow_t workflow;
+static polip_rpc_workflow_t rpcWorkflow;
+static polip_mqtt_t mqtt;
+
+static unsigned long reconnectTimer = 0;
+static int level = 0;
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _reconnect(unsigned long currentTime_ms);
+static void _pushStateSetup(polip_device_t* dev, JsonDocument& doc);
+static void _pollStateResp(polip_device_t* dev, JsonDocument& doc);
+static void _workflowError(polip_device_t* dev, JsonDocument& doc,
+        polip_workflow_source_t source, polip_ret_code_t error);
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params);
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc);
+
+//==============================================================================
+//  Setup / Loop
+//==============================================================================
+
+void setup() {
+    Serial.begin(115200);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    while (WiFi.status() != WL_CONNECTED) {
+        delay(500);
+    }
+
+    device.serialStr = SERIAL_STR;
+    device.keyStr = KEY;
+    device.keyStrLen = sizeof(KEY) - 1;
+    device.hardwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+    device.firmwareStr = POLIP_VERSION_STD_FORMAT(0,0,1);
+    device.buffer = buffer;
+    device.bufferLen = BUFFER_SIZE;
+
+    POLIP_RPC_WORKFLOW_ASSIGN_CORE_HOOKS(&rpcWorkflow, _acceptRPC, _cancelRPC);
+
+    workflow.device = &device;
+    workflow.rpcWorkflow = &rpcWorkflow;
+    workflow.hooks.pushStateSetupCb = _pushStateSetup;
+    workflow.hooks.pollStateRespCb = _pollStateResp;
+    workflow.hooks.workflowErrorCb = _workflowError;
+
+    mqttClient.setServer(MQTT_BROKER_HOST, MQTT_BROKER_PORT);
+    mqttClient.setBufferSize(MQTT_PACKET_SIZE);
+
+    mqtt.client = &mqttClient;
+    mqtt.device = &device;
+    mqtt.rpcWorkflow = &rpcWorkflow;
+    mqtt.buffer = rxBuffer;
+    mqtt.bufferLen = BUFFER_SIZE;
+
+    _reconnect(millis());
+    polip_workflow_initialize(&workflow, millis());
+}
+
+void loop() {
+    unsigned long now = millis();
+
+    if (!mqttClient.connected()) {
+        polip_mqtt_teardown(&mqtt); // Fall back to HTTP until broker returns
+        if ((now - reconnectTimer) >= MQTT_RECONNECT_PERIOD_MS) {
+            _reconnect(now);
+        }
+    } else if (polip_mqtt_loop(&mqtt, doc, TIMESTAMP) != POLIP_OK) {
+        Serial.println("Rejected RPC push");
+    }
+
+    polip_workflow_periodic_update(&workflow, doc, TIMESTAMP, now);
+
+    if (POLIP_WORKFLOW_IN_ERROR(&workflow)) {
+        POLIP_WORKFLOW_ACK_ERROR(&workflow);
+    }
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _reconnect(unsigned long currentTime_ms) {
+    reconnectTimer = currentTime_ms;
+    if (mqttClient.connect(SERIAL_STR) && polip_mqtt_initialize(&mqtt) == POLIP_OK) {
+        Serial.println("MQTT transport linked");
+    }
+}
+
+static void _pushStateSetup(polip_device_t* dev, JsonDocument& doc) {
+    doc["state"]["level"] = level;
+}
+
+static void _pollStateResp(polip_device_t* dev, JsonDocument& doc) {
+    if (doc.containsKey("state")) {
+        level = doc["state"]["level"] | level;
+    }
+}
+
+static void _workflowError(polip_device_t* dev, JsonDocument& doc,
+        polip_workflow_source_t source, polip_ret_code_t error) {
+    Serial.print("Workflow error ");
+    Serial.print((int)source);
+    Serial.print(" ");
+    Serial.println((int)error);
+}
+
+static bool _acceptRPC(polip_device_t* dev, polip_rpc_t* rpc, JsonObject& params) {
+    POLIP_RPC_WORKFLOW_RPC_SUCCEEDED(&rpcWorkflow, rpc);
+    return true;
+}
+
+static bool _cancelRPC(polip_device_t* dev, polip_rpc_t* rpc) {
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""
+Minimal CoAP (RFC 7252 / 7959) stand-in for exercising the polip CoAP
+transport on Linux. Reassembles Block1 requests, forwards them as HTTP POSTs
+to an ingest server (or echoes them back with --echo), and serves large
+replies with Block2.
+
+    coap://<host>:5683/api/device/v1/state?x=y  ->  POST <server>/api/device/v1/state?x=y
+
+Use --loss to drop a fraction of datagrams and watch retransmission.
+"""
+
+import argparse
+import random
+import socket
+import struct
+
+import urllib.error
+import urllib.request
+
+CON, NON, ACK, RST = 0, 1, 2, 3
+URI_PATH, CONTENT_FORMAT, URI_QUERY, BLOCK2, BLOCK1 = 11, 12, 15, 23, 27
+CONTINUE, VALID, CONTENT = 0x5F, 0x43, 0x45
+FORMATS = {50: "application/json", 65000: "application/msgpack"}
+
+
+def parse(data):
+    ver_type_tkl, code, mid = struct.unpack("!BBH", data[:4])
+    tkl = ver_type_tkl & 0x0F
+    msg = {"type": (ver_type_tkl >> 4) & 3, "code": code, "mid": mid,
+           "token": data[4:4 + tkl], "options": [], "payload": b""}
+    pos, number = 4 + tkl, 0
+    while pos < len(data):
+        if data[pos] == 0xFF:
+            msg["payload"] = data[pos + 1:]
+            break
+        delta, length = data[pos] >> 4, data[pos] & 0x0F
+        pos += 1
+        fields = []
+        for field in (delta, length):
+            if field == 13:
+                field, pos = data[pos] + 13, pos + 1
+            elif field == 14:
+                field, pos = struct.unpack("!H", data[pos:pos + 2])[0] + 269, pos + 2
+            fields.append(field)
+        number += fields[0]
+        msg["options"].append((number, data[pos:pos + fields[1]]))
+        pos += fields[1]
+    return msg
+
+
+def option(msg, number, default=None):
+    values = [v for n, v in msg["options"] if n == number]
+    return values if number in (URI_PATH, URI_QUERY) else (values[0] if values else default)
+
+
+def uint(value):
+    return int.from_bytes(value, "big") if value else 0
+
+
+def encode(msg_type, code, mid, token, options=(), payload=b""):
+    out = bytearray(struct.pack("!BBH", 0x40 | (msg_type << 4) | len(token), code, mid)) + token
+    last = 0
+    for number, value in sorted(options):
+        delta, length = number - last, len(value)
+        ext = b""
+        nibbles = []
+        for field in (delta, length):
+            if field < 13:
+                nibbles.append(field)
+            elif field < 269:
+                nibbles.append(13)
+                ext += bytes([field - 13])
+            else:
+                nibbles.append(14)
+                ext += struct.pack("!H", field - 269)
+        out += bytes([(nibbles[0] << 4) | nibbles[1]]) + ext + value
+        last = number
+    if payload:
+        out += b"\xff" + payload
+    return bytes(out)
+
+
+def block_value(num, more, szx):
+    value = (num << 4) | (0x08 if more else 0) | szx
+    return value.to_bytes((value.bit_length() + 7) // 8, "big") if value else b""
+
+
+def coap_code(status):
+    if status == 304:
+        return VALID
+    if status < 300:
+        return CONTENT
+    return ((status // 100) << 5) | min(status % 100, 31)
+
+
+class StandIn:
+    def __init__(self, args):
+        self.args = args
+        self.uploads = {}   # (addr, token) -> bytearray of Block1 payload
+        self.replies = {}   # (addr, token) -> (code, body, szx)
+        self.recent = {}    # (addr, mid) -> reply, answers retransmissions without re-forwarding
+        self.mid = random.randrange(0x10000)
+
+    def forward(self, msg, body):
+        if self.args.echo:
+            return 200, bytes(body)
+        path = "/" + "/".join(p.decode() for p in option(msg, URI_PATH))
+        query = "&".join(q.decode() for q in option(msg, URI_QUERY))
+        url = self.args.server + path + ("?" + query if query else "")
+        content_type = FORMATS.get(uint(option(msg, CONTENT_FORMAT)), "application/json")
+        request = urllib.request.Request(url, data=bytes(body), method="POST",
+                                         headers={"Content-Type": content_type, "Accept": content_type})
+        try:
+            with urllib.request.urlopen(request, timeout=10) as reply:
+                return reply.status, reply.read()
+        except urllib.error.HTTPError as err:
+            return err.code, err.read()
+        except OSError as err:
+            return 502, str(err).encode()
+
+    def handle(self, data, addr):
+        msg = parse(data)
+        if msg["type"] not in (CON, NON) or msg["code"] == 0:
+            return None
+        key = (addr, msg["token"])
+        options = []
+
+        block2 = option(msg, BLOCK2)
+        if block2 is not None and key in self.replies:
+            code, body, _ = self.replies[key]
+            szx = uint(block2) & 0x07
+            num = uint(block2) >> 4
+        else:
+            block1 = option(msg, BLOCK1)
+            body = self.uploads.setdefault(key, bytearray())
+            body += msg["payload"]
+            if block1 is not None:
+                options.append((BLOCK1, block1))
+                if uint(block1) & 0x08:
+                    return self.reply(msg, CONTINUE, options)
+            body = self.uploads.pop(key)
+            status, body = self.forward(msg, body)
+            code, num = coap_code(status), 0
+            szx = (uint(block1) & 0x07) if block1 is not None else self.args.szx
+            print(f"{addr[0]}:{addr[1]} {len(data)}B -> {status} {len(body)}B")
+
+        size = 16 << szx
+        if len(body) > size:
+            more = (num + 1) * size < len(body)
+            options.append((BLOCK2, block_value(num, more, szx)))
+            self.replies[key] = (code, body, szx)
+            body = body[num * size:(num + 1) * size]
+        return self.reply(msg, code, options, body)
+
+    def reply(self, msg, code, options, payload=b""):
+        if msg["type"] == CON:
+            return encode(ACK, code, msg["mid"], msg["token"], options, payload)
+        self.mid = (self.mid + 1) & 0xFFFF
+        return encode(NON, code, self.mid, msg["token"], options, payload)
+
+    def serve(self):
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind((self.args.host, self.args.port))
+        print(f"CoAP stand-in on {self.args.host}:{self.args.port}")
+        while True:
+            data, addr = sock.recvfrom(2048)
+            if random.random() < self.args.loss:
+                continue
+            key = (addr, struct.unpack("!H", data[2:4])[0])
+            out = self.recent.get(key) or self.handle(data, addr)
+            if len(self.recent) > 256:
+                self.recent.clear()
+            self.recent[key] = out
+            if out is not None and random.random() >= self.args.loss:
+                sock.sendto(out, addr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=5683)
+    parser.add_argument("--server", default="http://localhost:3021")
+    parser.add_argument("--echo", action="store_true", help="reply with request body instead of forwarding")
+    parser.add_argument("--szx", type=int, default=4, help="Block2 size exponent for replies (16 << szx bytes)")
+    parser.add_argument("--loss", type=float, default=0.0, help="fraction of datagrams dropped each way")
+    StandIn(parser.parse_args()).serve()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the device ingest server, for driving the FleetSimulator
+example (or any device) without the real backend.
+
+Implements the device endpoints with the same value and tag rules as the
+server, keeps state and RPCs per serial, and prints aggregate request rate,
+handling latency and RPC counts as one JSON object per report.
+
+Device keys are derived as SHA-256(key seed + serial), the same derivation
+the simulator uses, so request tags are verified and replies are signed.
+JSON bodies only; msgpack requests get 415 so devices fall back to JSON.
+"""
+
+import argparse
+import gzip
+import hashlib
+import hmac
+import json
+import random
+import re
+import threading
+import time
+import uuid
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+TAG_PATTERN = re.compile(rb'"tag":"([0-9a-f]{64})"')
+FINAL_STATUSES = ("success", "failure", "rejected")
+LATENCY_BOUNDS_US = (1000, 10000, 50000, 100000, 250000, 500000, 1000000)
+
+
+class Device:
+    def __init__(self, key):
+        self.key = key
+        self.low = 0            # Lowest value not yet used
+        self.used = set()       # Values used above low, out of order in windowed mode
+        self.state = {"level": 0}
+        self.version = 1
+        self.rpcs = {}          # uuid -> rpc object as sent to device
+
+
+class Server:
+    def __init__(self, args):
+        self.args = args
+        self.lock = threading.Lock()
+        self.devices = {}
+        self.counts = {}
+        self.latency = [0] * (len(LATENCY_BOUNDS_US) + 1)
+        self.rejects = {"value": 0, "tag": 0, "encoding": 0}
+        self.rpcs = {"created": 0, "completed": 0}
+        self.requests = 0
+        self.last_requests = 0
+
+    def device(self, serial):
+        if serial not in self.devices:
+            key = hashlib.sha256((self.args.key_seed + serial).encode()).digest()
+            self.devices[serial] = Device(key)
+        return self.devices[serial]
+
+    def use_value(self, dev, value):
+        window = self.args.window
+        if value is None or not dev.low <= value < dev.low + window or value in dev.used:
+            return False
+        dev.used.add(value)
+        while dev.low in dev.used:
+            dev.used.remove(dev.low)
+            dev.low += 1
+        return True
+
+    def record(self, endpoint, code, elapsed_us):
+        with self.lock:
+            self.requests += 1
+            key = f"{endpoint} {code}"
+            self.counts[key] = self.counts.get(key, 0) + 1
+            bucket = next((i for i, b in enumerate(LATENCY_BOUNDS_US) if elapsed_us <= b), len(LATENCY_BOUNDS_US))
+            self.latency[bucket] += 1
+
+    def report(self):
+        with self.lock:
+            out = {
+                "devices": len(self.devices),
+                "requests": self.requests,
+                "req_per_s": (self.requests - self.last_requests) / self.args.report,
+                "responses": dict(sorted(self.counts.items())),
+                "rejects": dict(self.rejects),
+                "rpcs": dict(self.rpcs),
+                "latency_hist_us": self.latency,
+            }
+            self.last_requests = self.requests
+        print(json.dumps(out), flush=True)
+
+
+def sign(obj, key):
+    """Serializes reply the way ArduinoJson re-serializes it for verification"""
+    obj["tag"] = "0"
+    body = json.dumps(obj, separators=(",", ":"), ensure_ascii=False).encode()
+    tag = hmac.new(key, body, hashlib.sha256).hexdigest()
+    return body.replace(b'"tag":"0"', f'"tag":"{tag}"'.encode(), 1)
+
+
+def verify(raw, key):
+    match = TAG_PATTERN.search(raw)
+    if match is None:
+        return False
+    signed = raw[:match.start(1)] + b"0" + raw[match.end(1):]
+    return hmac.compare_digest(match.group(1).decode(), hmac.new(key, signed, hashlib.sha256).hexdigest())
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"   # Keep-alive, as linked connections expect
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def reply(self, code, body=b""):
+        self.send_response(code)
+        if body:
+            self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+        return code
+
+    def do_GET(self):
+        start = time.perf_counter()
+        path = urlparse(self.path).path
+        code = self.reply(200, b'"ok"') if path.endswith("/health/check") else self.reply(404)
+        self.server.state.record(path, code, (time.perf_counter() - start) * 1e6)
+
+    def do_POST(self):
+        start = time.perf_counter()
+        url = urlparse(self.path)
+        raw = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        code = self.handle_post(url.path, parse_qs(url.query), raw)
+        self.server.state.record(url.path, code, (time.perf_counter() - start) * 1e6)
+
+    def handle_post(self, path, query, raw):
+        srv = self.server.state
+        if self.server.delay_s > 0:
+            time.sleep(self.server.delay_s)
+
+        if "msgpack" in self.headers.get("Content-Type", ""):
+            with srv.lock:
+                srv.rejects["encoding"] += 1
+            return self.reply(415)
+        if self.headers.get("Content-Encoding") == "gzip":
+            raw = gzip.decompress(raw)
+
+        try:
+            req = json.loads(raw)
+        except ValueError:
+            return self.reply(400, b'"body invalid"')
+
+        serial = req.get("serial", "")
+        with srv.lock:
+            dev = srv.device(serial)
+            if path.endswith("/device/v1/value"):
+                resp = {"value": dev.low}
+                if srv.args.window > 1:
+                    resp["window"] = min(srv.args.window, req.get("window", 1))
+                return self.reply(200, json.dumps(resp, separators=(",", ":")).encode())
+
+            if not verify(raw, dev.key):
+                srv.rejects["tag"] += 1
+                return self.reply(401, b'"tag invalid"')
+            if not srv.use_value(dev, req.get("value")):
+                srv.rejects["value"] += 1
+                return self.reply(400, b'"value invalid"')
+
+            resp = {"serial": serial, "value": req["value"]}
+            flag = lambda name: query.get(name, ["false"])[0] == "true"
+
+            if "state" in req and not path.endswith("/poll"):
+                dev.state = req["state"]
+                dev.version += 1
+
+            if "rpc" in req and path.endswith("/device/rpc"):
+                rpc = dev.rpcs.get(req["rpc"].get("uuid"))
+                if rpc is not None:
+                    rpc["status"] = req["rpc"]["status"]
+                    if rpc["status"] in FINAL_STATUSES:
+                        del dev.rpcs[rpc["uuid"]]
+                        srv.rpcs["completed"] += 1
+
+            polling = path.endswith("/poll") or (path.endswith("/exchange") and flag("poll"))
+            if polling:
+                if flag("rpc") and random.random() < srv.args.rpc_rate:
+                    rpc = {"uuid": str(uuid.uuid4()), "type": "sim", "status": "pending", "parameters": {}}
+                    dev.rpcs[rpc["uuid"]] = rpc
+                    srv.rpcs["created"] += 1
+
+                version = query.get("version", [None])[0]
+                if path.endswith("/poll") and version == str(dev.version) and not dev.rpcs:
+                    return self.reply(304)
+
+                resp["version"] = dev.version
+                if flag("state"):
+                    resp["state"] = dev.state
+                if flag("rpc"):
+                    resp["rpc"] = list(dev.rpcs.values())
+
+            return self.reply(200, sign(resp, dev.key))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=3021)
+    parser.add_argument("--key-seed", default="polip-fleet", help="must match FLEET_KEY_SEED")
+    parser.add_argument("--window", type=int, default=1, help="value window granted, 1 is strict")
+    parser.add_argument("--rpc-rate", type=float, default=0.05, help="chance a poll queues a new RPC")
+    parser.add_argument("--delay-ms", type=float, default=0, help="added handling time per request")
+    parser.add_argument("--report", type=float, default=10, help="report period in seconds")
+    args = parser.parse_args()
+
+    httpd = ThreadingHTTPServer((args.host, args.port), Handler)
+    httpd.daemon_threads = True
+    httpd.state = Server(args)
+    httpd.delay_s = args.delay_ms / 1000
+
+    def report():
+        while True:
+            time.sleep(args.report)
+            httpd.state.report()
+
+    threading.Thread(target=report, daemon=True).start()
+    httpd.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Forwards polip MQTT transport requests to an HTTP ingest server and publishes
+the replies, so the MQTT transport can be exercised against a local broker
+before the server speaks MQTT itself.
+
+    polip/v1/<serial>/req/<seq>/<path>   ->  POST <server>/api/<path>
+    polip/v1/<serial>/res/<seq>/<code>   <-  reply body, code is HTTP status
+
+The device drops replies whose sequence does not match its pending request.
+
+RPC pushes (polip/v1/<serial>/rpc) must be tagged with the device key, so
+they come from the server (or mosquitto_pub of a captured poll reply).
+
+Requires paho-mqtt and requests.
+"""
+
+import argparse
+
+import paho.mqtt.client as mqtt
+import requests
+
+PREFIX = "polip/v1/"
+
+
+def on_message(client, server, msg):
+    levels = msg.topic[len(PREFIX):].split("/", 3)
+    if len(levels) < 4 or levels[1] != "req":
+        return
+    serial, seq, path = levels[0], levels[2], levels[3]
+
+    json = msg.payload[:1] in (b"{", b"[")
+    headers = {"Content-Type": "application/json" if json else "application/msgpack"}
+    if not json:
+        headers["Accept"] = "application/msgpack"
+
+    try:
+        reply = requests.post(server + "/api/" + path, data=msg.payload, headers=headers, timeout=10)
+        code, body = reply.status_code, reply.content
+    except requests.RequestException as err:
+        code, body = 502, str(err).encode()
+
+    print(f"{serial} /api/{path} -> {code}")
+    client.publish(f"{PREFIX}{serial}/res/{seq}/{code}", body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--broker", default="localhost")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--server", default="http://localhost:3021")
+    args = parser.parse_args()
+
+    client = mqtt.Client(userdata=args.server.rstrip("/"))
+    client.on_message = on_message
+    client.connect(args.broker, args.port)
+    client.subscribe(PREFIX + "+/req/#")
+    client.loop_forever()
+
+
+if __name__ == "__main__":
+    main()
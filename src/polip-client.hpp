@@ -7,9 +7,23 @@
 //  Libraries
 //==============================================================================
 
+#include "./polip-coap.hpp"
+#include "./polip-compress.hpp"
 #include "./polip-core.hpp"
 #include "./polip-device.hpp"
+#include "./polip-dns.hpp"
+#include "./polip-gateway.hpp"
+#include "./polip-longpoll.hpp"
+#include "./polip-mqtt.hpp"
+#include "./polip-notify.hpp"
 #include "./polip-rpc-workflow.hpp"
+#include "./polip-schema.hpp"
+#include "./polip-servers.hpp"
+#include "./polip-stats.hpp"
+#include "./polip-tag.hpp"
+#include "./polip-tls.hpp"
+#include "./polip-trace.hpp"
+#include "./polip-value-store.hpp"
 #include "./polip-workflow.hpp"
 
 //==============================================================================
@@ -0,0 +1,467 @@
+/**
+ * @file polip-coap.cpp
+ * @author Curt Henrichs
+ * @brief Polip CoAP
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib CoAP over UDP request transport.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+#include <ESP8266WiFi.h>
+
+#include "./polip-coap.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define COAP_VERSION                                (1)
+#define COAP_TYPE_CON                               (0)
+#define COAP_TYPE_NON                               (1)
+#define COAP_TYPE_ACK                               (2)
+#define COAP_TYPE_RST                               (3)
+#define COAP_CODE_EMPTY                             (0x00)
+#define COAP_CODE_POST                              (0x02)
+#define COAP_CODE_CONTINUE                          (0x5F) // 2.31
+#define COAP_CODE_VALID                             (0x43) // 2.03
+#define COAP_OPTION_URI_PATH                        (11)
+#define COAP_OPTION_CONTENT_FORMAT                  (12)
+#define COAP_OPTION_URI_QUERY                       (15)
+#define COAP_OPTION_BLOCK2                          (23)
+#define COAP_OPTION_BLOCK1                          (27)
+#define COAP_FORMAT_JSON                            (50)
+#define COAP_FORMAT_MSGPACK                         (65000) // Experimental range, none registered
+#define COAP_PAYLOAD_MARKER                         (0xFF)
+#define COAP_HEADER_LEN                             (4)
+#define COAP_TOKEN_LEN                              (4)
+#define COAP_BLOCK_MORE                             (0x08)
+#define COAP_BLOCK_SZX_MASK                         (0x07)
+#define COAP_NO_BLOCK                               (0xFFFFFFFFUL)
+#define COAP_SENSE_PATH                             "/sense"
+
+//==============================================================================
+//  Private Data Structure Declaration
+//==============================================================================
+
+typedef struct _coap_request {
+    const char* path;
+    bool confirmable;
+    uint16_t format;
+    const uint8_t* payload;
+    size_t len;
+    uint32_t block1;                //! COAP_NO_BLOCK if not block-wise
+    uint32_t block2;                //! COAP_NO_BLOCK unless fetching later reply block
+} _coap_request_t;
+
+typedef struct _coap_reply {
+    uint8_t code;
+    const uint8_t* payload;
+    size_t payloadLen;
+    uint32_t block2;                //! COAP_NO_BLOCK if reply fits one datagram
+} _coap_reply_t;
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static int _exchange(void* context, polip_device_t* dev, const char* path,
+        const uint8_t* body, size_t len, const char** response, size_t* responseLen);
+static bool _transact(polip_coap_t* coap, const _coap_request_t* req, _coap_reply_t* reply);
+static size_t _buildRequest(polip_coap_t* coap, const _coap_request_t* req, uint8_t type, uint16_t messageId);
+static bool _writeOption(uint8_t* buf, size_t cap, size_t* pos, uint16_t* last,
+        uint16_t number, const uint8_t* value, size_t len);
+static bool _writeUintOption(uint8_t* buf, size_t cap, size_t* pos, uint16_t* last,
+        uint16_t number, uint32_t value);
+static bool _parseReply(polip_coap_t* coap, const uint8_t* buf, size_t len, _coap_reply_t* reply);
+static bool _readExtended(const uint8_t* buf, size_t len, size_t* pos, uint8_t nibble, uint32_t* value);
+static void _sendEmpty(polip_coap_t* coap, uint8_t type, uint16_t messageId);
+static uint8_t _blockSzx(uint16_t blockSize);
+static int _httpCode(uint8_t code);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_coap_initialize(polip_coap_t* coap, polip_device_t* dev) {
+    if (coap->host == NULL || coap->packet == NULL || coap->buffer == NULL
+            || _blockSzx(coap->params.blockSize) > 6
+            || coap->packetLen < coap->params.blockSize + POLIP_COAP_PACKET_OVERHEAD) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    if (!WiFi.hostByName(coap->host, coap->address)) {
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+
+    if (!coap->udp.begin(0)) { // Ephemeral local port
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+
+    // Random start keeps IDs of a rebooted node from matching stale replies
+    coap->state.messageId = (uint16_t)random(0x10000);
+    coap->state.token = (uint32_t)random(0x7FFFFFFF);
+
+    coap->transport.exchange = _exchange;
+    coap->transport.context = coap;
+    dev->transport = &coap->transport;
+    return POLIP_OK;
+}
+
+void polip_coap_teardown(polip_coap_t* coap, polip_device_t* dev) {
+    if (dev->transport == &coap->transport) {
+        dev->transport = NULL;
+    }
+    coap->udp.stop();
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static int _exchange(void* context, polip_device_t* dev, const char* path,
+        const uint8_t* body, size_t len, const char** response, size_t* responseLen) {
+    polip_coap_t* coap = (polip_coap_t*)context;
+    uint16_t block = coap->params.blockSize;
+    uint8_t szx = _blockSzx(block);
+    _coap_reply_t reply;
+    _coap_request_t req;
+
+    req.path = path;
+    // Lost sense push is superseded by the next one, unless it spans blocks.
+    //  Strict value window cannot tell a lost request from a lost reply, the
+    //  server may have consumed the value, so only windowed mode skips CON
+    req.confirmable = !(coap->params.nonConfirmableSense && dev->valueWindow > 1 && len <= block 
+        && strstr(path, COAP_SENSE_PATH) != NULL);
+    req.format = (dev->encoding == POLIP_ENCODING_MSGPACK) ? COAP_FORMAT_MSGPACK : COAP_FORMAT_JSON;
+    req.block2 = COAP_NO_BLOCK;
+
+    coap->state.token++; // One token per request, shared by its blocks
+
+    // Request body, Block1 when larger than one block
+    size_t offset = 0;
+    uint32_t num = 0;
+    do {
+        size_t chunk = (len - offset > block) ? block : len - offset;
+        bool more = (offset + chunk) < len;
+
+        req.payload = body + offset;
+        req.len = chunk;
+        req.block1 = (len > block) ? ((num << 4) | ((more) ? COAP_BLOCK_MORE : 0) | szx) : COAP_NO_BLOCK;
+
+        if (!_transact(coap, &req, &reply)) {
+            coap->state.timeouts++;
+            return -1;
+        }
+        if (num > 0) {
+            coap->state.blocks++;
+        }
+        if (more && reply.code != COAP_CODE_CONTINUE) {
+            break; // Server answered early, usually an error
+        }
+
+        offset += chunk;
+        num++;
+    } while (offset < len);
+
+    // Reply, Block2 when larger than one block, at whatever size server chose
+    req.payload = NULL;
+    req.len = 0;
+    req.block1 = COAP_NO_BLOCK;
+
+    size_t rxLen = 0;
+    for (num = 0; ; num++) {
+        if (reply.block2 != COAP_NO_BLOCK && (reply.block2 >> 4) != num) {
+            return -1; // Out of sequence
+        }
+        if (reply.payloadLen > (size_t)(coap->bufferLen - rxLen)) {
+            return -1; // Too large, treated like an unanswered request
+        }
+        if (reply.payloadLen > 0) {
+            memcpy(coap->buffer + rxLen, reply.payload, reply.payloadLen);
+            rxLen += reply.payloadLen;
+        }
+
+        if (reply.block2 == COAP_NO_BLOCK || !(reply.block2 & COAP_BLOCK_MORE)) {
+            break;
+        }
+
+        req.block2 = ((num + 1) << 4) | (reply.block2 & COAP_BLOCK_SZX_MASK);
+        if (!_transact(coap, &req, &reply)) {
+            coap->state.timeouts++;
+            return -1;
+        }
+        coap->state.blocks++;
+    }
+
+    coap->state.exchanges++;
+    *response = coap->buffer;
+    *responseLen = rxLen;
+    return _httpCode(reply.code);
+}
+
+static bool _transact(polip_coap_t* coap, const _coap_request_t* req, _coap_reply_t* reply) {
+    uint16_t messageId = ++coap->state.messageId;
+    unsigned long timeout = (req->confirmable) ? coap->params.ackTimeout : coap->params.nonTimeout;
+    uint8_t attempts = (req->confirmable) ? coap->params.maxRetransmit + 1 : 1;
+    uint8_t* packet = (uint8_t*)coap->packet;
+    bool acked = false;
+
+    for (uint8_t attempt = 0; attempt < attempts; attempt++) {
+        if (!acked) {
+            // Rebuilt each attempt since replies are received into same scratch
+            size_t n = _buildRequest(coap, req, (req->confirmable) ? COAP_TYPE_CON : COAP_TYPE_NON, messageId);
+            if (n == 0) {
+                return false;
+            }
+            coap->udp.beginPacket(coap->address, coap->port);
+            coap->udp.write(packet, n);
+            coap->udp.endPacket();
+            if (attempt > 0) {
+                coap->state.retransmits++;
+            }
+        }
+
+        unsigned long start = millis();
+        while ((millis() - start) < timeout) {
+            if (coap->udp.parsePacket() <= 0) {
+                yield();
+                continue;
+            }
+
+            int n = coap->udp.read(packet, coap->packetLen);
+            if (n < COAP_HEADER_LEN || (packet[0] >> 6) != COAP_VERSION) {
+                continue;
+            }
+
+            uint8_t type = (packet[0] >> 4) & 0x03;
+            uint16_t id = ((uint16_t)packet[2] << 8) | packet[3];
+
+            if (type == COAP_TYPE_RST && id == messageId) {
+                return false;
+            } else if (type == COAP_TYPE_ACK && id != messageId) {
+                continue; // Duplicate of an earlier block's reply
+            } else if (type == COAP_TYPE_ACK && packet[1] == COAP_CODE_EMPTY) {
+                acked = true; // Separate reply follows, stop retransmitting
+                continue;
+            }
+
+            if (!_parseReply(coap, packet, n, reply)) {
+                continue;
+            }
+            if (type == COAP_TYPE_CON) {
+                _sendEmpty(coap, COAP_TYPE_ACK, id);
+            }
+            return true;
+        }
+
+        timeout *= 2;
+    }
+
+    return false;
+}
+
+static size_t _buildRequest(polip_coap_t* coap, const _coap_request_t* req, uint8_t type, uint16_t messageId) {
+    uint8_t* buf = (uint8_t*)coap->packet;
+    size_t cap = coap->packetLen;
+    size_t pos = 0;
+    uint16_t last = 0;
+
+    buf[pos++] = (COAP_VERSION << 6) | (type << 4) | COAP_TOKEN_LEN;
+    buf[pos++] = COAP_CODE_POST;
+    buf[pos++] = messageId >> 8;
+    buf[pos++] = messageId & 0xFF;
+    for (int i = COAP_TOKEN_LEN - 1; i >= 0; i--) {
+        buf[pos++] = (coap->state.token >> (8 * i)) & 0xFF;
+    }
+
+    // Options must be written in ascending number order
+    const char* query = strchr(req->path, '?');
+    const char* end = (query != NULL) ? query : req->path + strlen(req->path);
+    for (const char* seg = req->path; seg < end; ) {
+        const char* next = seg;
+        while (next < end && *next != '/') {
+            next++;
+        }
+        if (next > seg && !_writeOption(buf, cap, &pos, &last, COAP_OPTION_URI_PATH, (const uint8_t*)seg, next - seg)) {
+            return 0;
+        }
+        seg = next + 1;
+    }
+
+    if (req->len > 0 && !_writeUintOption(buf, cap, &pos, &last, COAP_OPTION_CONTENT_FORMAT, req->format)) {
+        return 0;
+    }
+
+    if (query != NULL) {
+        for (const char* param = query + 1; *param != '\0'; ) {
+            const char* next = strchr(param, '&');
+            size_t paramLen = (next != NULL) ? (size_t)(next - param) : strlen(param);
+            if (paramLen > 0 && !_writeOption(buf, cap, &pos, &last, COAP_OPTION_URI_QUERY, (const uint8_t*)param, paramLen)) {
+                return 0;
+            }
+            param += paramLen + ((next != NULL) ? 1 : 0);
+        }
+    }
+
+    if (req->block2 != COAP_NO_BLOCK && !_writeUintOption(buf, cap, &pos, &last, COAP_OPTION_BLOCK2, req->block2)) {
+        return 0;
+    }
+    if (req->block1 != COAP_NO_BLOCK && !_writeUintOption(buf, cap, &pos, &last, COAP_OPTION_BLOCK1, req->block1)) {
+        return 0;
+    }
+
+    if (req->len > 0) {
+        if (pos + 1 + req->len > cap) {
+            return 0;
+        }
+        buf[pos++] = COAP_PAYLOAD_MARKER;
+        memcpy(buf + pos, req->payload, req->len);
+        pos += req->len;
+    }
+
+    return pos;
+}
+
+static bool _writeOption(uint8_t* buf, size_t cap, size_t* pos, uint16_t* last,
+        uint16_t number, const uint8_t* value, size_t len) {
+    uint32_t fields[2] = {(uint32_t)(number - *last), (uint32_t)len};
+    uint8_t nibbles[2];
+    size_t need = 1 + len;
+
+    for (int i = 0; i < 2; i++) {
+        nibbles[i] = (fields[i] < 13) ? fields[i] : (fields[i] < 269) ? 13 : 14;
+        need += (nibbles[i] == 13) ? 1 : (nibbles[i] == 14) ? 2 : 0;
+    }
+    if (*pos + need > cap || len >= 65805) {
+        return false;
+    }
+
+    buf[(*pos)++] = (nibbles[0] << 4) | nibbles[1];
+    for (int i = 0; i < 2; i++) {
+        if (nibbles[i] == 13) {
+            buf[(*pos)++] = fields[i] - 13;
+        } else if (nibbles[i] == 14) {
+            buf[(*pos)++] = (fields[i] - 269) >> 8;
+            buf[(*pos)++] = (fields[i] - 269) & 0xFF;
+        }
+    }
+    memcpy(buf + *pos, value, len);
+    *pos += len;
+
+    *last = number;
+    return true;
+}
+
+static bool _writeUintOption(uint8_t* buf, size_t cap, size_t* pos, uint16_t* last,
+        uint16_t number, uint32_t value) {
+    uint8_t bytes[4];
+    size_t len = 0;
+
+    // Minimal big-endian, zero is empty
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        uint8_t b = (value >> shift) & 0xFF;
+        if (len > 0 || b != 0) {
+            bytes[len++] = b;
+        }
+    }
+    return _writeOption(buf, cap, pos, last, number, bytes, len);
+}
+
+static bool _parseReply(polip_coap_t* coap, const uint8_t* buf, size_t len, _coap_reply_t* reply) {
+    uint8_t tkl = buf[0] & 0x0F;
+    if (tkl != COAP_TOKEN_LEN || len < COAP_HEADER_LEN + tkl) {
+        return false;
+    }
+    for (int i = 0; i < COAP_TOKEN_LEN; i++) {
+        if (buf[COAP_HEADER_LEN + i] != ((coap->state.token >> (8 * (COAP_TOKEN_LEN - 1 - i))) & 0xFF)) {
+            return false; // Reply to another request
+        }
+    }
+
+    reply->code = buf[1];
+    reply->payload = NULL;
+    reply->payloadLen = 0;
+    reply->block2 = COAP_NO_BLOCK;
+
+    size_t pos = COAP_HEADER_LEN + tkl;
+    uint32_t number = 0;
+    while (pos < len) {
+        if (buf[pos] == COAP_PAYLOAD_MARKER) {
+            reply->payload = buf + pos + 1;
+            reply->payloadLen = len - pos - 1;
+            break;
+        }
+
+        uint8_t header = buf[pos++];
+        uint32_t delta, optionLen;
+        if (!_readExtended(buf, len, &pos, header >> 4, &delta)
+                || !_readExtended(buf, len, &pos, header & 0x0F, &optionLen)
+                || pos + optionLen > len) {
+            return false;
+        }
+
+        number += delta;
+        if (number == COAP_OPTION_BLOCK2 && optionLen <= 3) {
+            reply->block2 = 0;
+            for (uint32_t i = 0; i < optionLen; i++) {
+                reply->block2 = (reply->block2 << 8) | buf[pos + i];
+            }
+        }
+        pos += optionLen;
+    }
+
+    return true;
+}
+
+static bool _readExtended(const uint8_t* buf, size_t len, size_t* pos, uint8_t nibble, uint32_t* value) {
+    if (nibble < 13) {
+        *value = nibble;
+    } else if (nibble == 13 && *pos + 1 <= len) {
+        *value = buf[*pos] + 13;
+        *pos += 1;
+    } else if (nibble == 14 && *pos + 2 <= len) {
+        *value = (((uint32_t)buf[*pos] << 8) | buf[*pos + 1]) + 269;
+        *pos += 2;
+    } else {
+        return false; // 15 reserved, or truncated
+    }
+    return true;
+}
+
+static void _sendEmpty(polip_coap_t* coap, uint8_t type, uint16_t messageId) {
+    uint8_t msg[COAP_HEADER_LEN] = {
+        (uint8_t)((COAP_VERSION << 6) | (type << 4)), COAP_CODE_EMPTY,
+        (uint8_t)(messageId >> 8), (uint8_t)(messageId & 0xFF)
+    };
+
+    coap->udp.beginPacket(coap->address, coap->port);
+    coap->udp.write(msg, COAP_HEADER_LEN);
+    coap->udp.endPacket();
+}
+
+static uint8_t _blockSzx(uint16_t blockSize) {
+    for (uint8_t szx = 0; szx <= 6; szx++) {
+        if (blockSize == (16 << szx)) {
+            return szx;
+        }
+    }
+    return 0xFF;
+}
+
+static int _httpCode(uint8_t code) {
+    uint8_t cls = code >> 5;
+    uint8_t detail = code & 0x1F;
+
+    if (cls == 2) {
+        return (code == COAP_CODE_VALID) ? 304 : 200;
+    }
+    return cls * 100 + detail;
+}
\ No newline at end of file
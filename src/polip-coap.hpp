@@ -0,0 +1,159 @@
+/**
+ * @file polip-coap.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional CoAP over UDP transport (RFC 7252) for nodes where a TCP and HTTP
+ * handshake per request costs more radio time than the request itself. The
+ * tagged request body is POSTed to the same path as over HTTP, split into
+ * Block1 transfers when larger than one block; large replies are fetched with
+ * Block2 (RFC 7959). Requests are confirmable and retransmitted with backoff,
+ * except sense pushes fitting one block which go non-confirmable and are not
+ * retried. Non-confirmable pushes need a value window of at least 2, in
+ * strict mode a lost reply would leave the value unknown to be consumed.
+ * 
+ * Replies map back to HTTP equivalent status: 2.03 Valid is 304, any other
+ * 2.xx is 200, errors keep class and detail (4.04 is 404).
+ */
+
+#ifndef POLIP_COAP_HPP
+#define POLIP_COAP_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <WiFiUdp.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Server port if not set
+#ifndef POLIP_COAP_DEFAULT_PORT
+#define POLIP_COAP_DEFAULT_PORT                     (5683)
+#endif
+
+//! Payload bytes per datagram, power of two from 16 to 1024
+#ifndef POLIP_COAP_DEFAULT_BLOCK_SIZE
+#define POLIP_COAP_DEFAULT_BLOCK_SIZE               (256)
+#endif
+
+//! Initial wait for acknowledgement, doubled on each retransmission
+#ifndef POLIP_COAP_DEFAULT_ACK_TIMEOUT
+#define POLIP_COAP_DEFAULT_ACK_TIMEOUT              (2000L)
+#endif
+
+//! Retransmissions of a confirmable message before giving up
+#ifndef POLIP_COAP_DEFAULT_MAX_RETRANSMIT
+#define POLIP_COAP_DEFAULT_MAX_RETRANSMIT           (4)
+#endif
+
+//! Wait for reply to a non-confirmable message
+#ifndef POLIP_COAP_DEFAULT_NON_TIMEOUT
+#define POLIP_COAP_DEFAULT_NON_TIMEOUT              (2000L)
+#endif
+
+//! Datagram bytes beyond payload needed for header, token and options
+#define POLIP_COAP_PACKET_OVERHEAD                  (160)
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * CoAP transport context, linked to device by application
+ */
+typedef struct _polip_coap {
+
+    /**
+     * Dedicated socket
+     */
+    WiFiUDP udp;
+
+    /**
+     * Server, resolved once on initialize
+     */
+    const char* host = NULL;
+    uint16_t port = POLIP_COAP_DEFAULT_PORT;
+    IPAddress address;
+
+    /**
+     * Datagram scratch, must be linked. At least block size plus
+     * POLIP_COAP_PACKET_OVERHEAD.
+     */
+    char* packet = NULL;
+    uint16_t packetLen = 0;
+
+    /**
+     * Reassembled reply, must be linked. Owned by transport until next request.
+     */
+    char* buffer = NULL;
+    uint16_t bufferLen = 0;
+
+    /**
+     * Interface linked into device, filled by initialize
+     */
+    polip_transport_t transport;
+
+    /**
+     * Inner table for parameters used by CoAP transport
+     * Defaults set as defined in struct
+     */
+    struct _polip_coap_params {
+        uint16_t blockSize = POLIP_COAP_DEFAULT_BLOCK_SIZE;
+        unsigned long ackTimeout = POLIP_COAP_DEFAULT_ACK_TIMEOUT;
+        uint8_t maxRetransmit = POLIP_COAP_DEFAULT_MAX_RETRANSMIT;
+        unsigned long nonTimeout = POLIP_COAP_DEFAULT_NON_TIMEOUT;
+        bool nonConfirmableSense = true; //! Single block sense pushes sent without retransmission, windowed mode only
+    } params;
+
+    /**
+     * Inner table for state used by CoAP transport
+     */
+    struct _polip_coap_state {
+        uint16_t messageId = 0;         //! Last message ID sent
+        uint32_t token = 0;             //! Last token sent
+        uint32_t exchanges = 0;         //! Requests answered
+        uint32_t retransmits = 0;       //! Confirmable messages resent
+        uint32_t timeouts = 0;          //! Requests unanswered
+        uint32_t blocks = 0;            //! Datagrams beyond first in block-wise transfers
+    } state;
+
+} polip_coap_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Opens socket, resolves server, and links transport into device
+ * 
+ * @param coap pointer to CoAP context, host / packet / buffer linked
+ * @param dev pointer to device
+ * @return polip_ret_code_t LIB_REQUEST if not linked or block size invalid;
+ *      SERVER_ERROR if host not resolved or socket not opened; OK otherwise
+ */
+polip_ret_code_t polip_coap_initialize(polip_coap_t* coap, polip_device_t* dev);
+/**
+ * @brief Unlinks transport from device and closes socket, requests revert to HTTP
+ * 
+ * @param coap pointer to CoAP context
+ * @param dev pointer to device
+ */
+void polip_coap_teardown(polip_coap_t* coap, polip_device_t* dev);
+
+//==============================================================================
+
+#endif //POLIP_COAP_HPP
\ No newline at end of file
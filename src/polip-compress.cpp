@@ -0,0 +1,667 @@
+/**
+ * @file polip-compress.cpp
+ * @author Curt Henrichs
+ * @brief Polip Compress
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib minimal gzip (RFC 1951 / RFC 1952) for constrained devices.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+
+#include "./polip-compress.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define GZIP_HEADER_SIZE                            (10)
+#define GZIP_TRAILER_SIZE                           (8)
+
+#define GZIP_FLAG_HCRC                              (0x02)
+#define GZIP_FLAG_EXTRA                             (0x04)
+#define GZIP_FLAG_NAME                              (0x08)
+#define GZIP_FLAG_COMMENT                           (0x10)
+
+#define DEFLATE_MIN_MATCH                           (3)
+#define DEFLATE_MAX_MATCH                           (258)
+#define DEFLATE_MAX_BITS                            (15)
+#define DEFLATE_MAX_LCODES                          (286)
+#define DEFLATE_MAX_DCODES                          (30)
+#define DEFLATE_FIX_LCODES                          (288)
+
+#define HASH_EMPTY                                  (0xFFFF)
+
+//==============================================================================
+//  Data Structure Declaration
+//==============================================================================
+
+/**
+ * LSB-first bit writer into bounded buffer
+ */
+typedef struct _bit_writer {
+    uint8_t* out;
+    size_t cap;
+    size_t pos;
+    uint32_t bitBuf;
+    uint8_t bitCnt;
+    bool overflow;
+} _bit_writer_t;
+
+/**
+ * LSB-first bit reader over bounded input and output
+ * Input is one buffer, or chunks refilled from read callback if set
+ */
+typedef struct _bit_reader {
+    const uint8_t* in;
+    size_t inLen;
+    size_t inPos;
+    polip_gzip_read_t read;
+    void* context;
+    uint8_t* chunk;
+    uint8_t* out;
+    size_t outCap;
+    size_t outPos;
+    uint32_t bitBuf;
+    uint8_t bitCnt;
+    bool error;
+} _bit_reader_t;
+
+/**
+ * Canonical Huffman decode table
+ */
+typedef struct _huffman {
+    uint16_t count[DEFLATE_MAX_BITS + 1];   //! Codes per length
+    uint16_t* symbol;                       //! Symbols ordered by code
+} _huffman_t;
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+static const uint16_t _lengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t _lengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t _distBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+
+static const uint8_t _distExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static const uint8_t _codeLengthOrder[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static const uint32_t _crcTable[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+//! Decode tables kept static to spare the stack, library is single threaded
+static uint16_t _lenSymbols[DEFLATE_FIX_LCODES];
+static uint16_t _distSymbols[DEFLATE_MAX_DCODES];
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _putBits(_bit_writer_t* bw, uint32_t value, uint8_t count);
+static void _putHuffman(_bit_writer_t* bw, uint16_t code, uint8_t count);
+static void _putLiteral(_bit_writer_t* bw, uint16_t symbol);
+static void _putMatch(_bit_writer_t* bw, uint16_t length, uint16_t distance);
+static void _flushBits(_bit_writer_t* bw);
+static void _putByte(_bit_writer_t* bw, uint8_t byte);
+static void _putLE32(_bit_writer_t* bw, uint32_t value);
+static uint16_t _hash3(const uint8_t* p);
+
+static bool _refill(_bit_reader_t* br);
+static bool _getByte(_bit_reader_t* br, uint8_t* byte);
+static bool _skipBytes(_bit_reader_t* br, size_t count);
+static uint32_t _getBits(_bit_reader_t* br, uint8_t count);
+static int _decode(_bit_reader_t* br, const _huffman_t* h);
+static bool _construct(_huffman_t* h, const uint8_t* lengths, int n);
+static bool _inflateStored(_bit_reader_t* br);
+static bool _inflateCodes(_bit_reader_t* br, const _huffman_t* lencode, const _huffman_t* distcode);
+static bool _inflateFixed(_bit_reader_t* br);
+static bool _inflateDynamic(_bit_reader_t* br);
+static bool _inflate(_bit_reader_t* br);
+static bool _gunzip(_bit_reader_t* br, size_t* outLen);
+static uint32_t _getLE32(const uint8_t* p);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+size_t polip_gzip_compress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outCap) {
+    static const uint8_t header[GZIP_HEADER_SIZE] = {
+        0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF
+    };
+
+    if (outCap < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) {
+        return 0;
+    }
+
+    _bit_writer_t bw = {out, outCap, 0, 0, 0, false};
+    for (int i = 0; i < GZIP_HEADER_SIZE; i++) {
+        _putByte(&bw, header[i]);
+    }
+
+    // Single final block of fixed Huffman codes
+    _putBits(&bw, 1, 1);
+    _putBits(&bw, 1, 2);
+
+    uint16_t head[POLIP_COMPRESS_HASH_SIZE];
+    for (int i = 0; i < POLIP_COMPRESS_HASH_SIZE; i++) {
+        head[i] = HASH_EMPTY;
+    }
+
+    size_t pos = 0;
+    while (pos < inLen && !bw.overflow) {
+        uint16_t bestLen = 0;
+        size_t bestDist = 0;
+
+        if (pos + DEFLATE_MIN_MATCH <= inLen && pos < HASH_EMPTY) {
+            uint16_t h = _hash3(&in[pos]);
+            uint16_t candidate = head[h];
+            head[h] = (uint16_t)pos;
+
+            if (candidate != HASH_EMPTY && pos - candidate <= POLIP_COMPRESS_WINDOW) {
+                size_t limit = inLen - pos;
+                if (limit > DEFLATE_MAX_MATCH) {
+                    limit = DEFLATE_MAX_MATCH;
+                }
+
+                uint16_t len = 0;
+                while (len < limit && in[candidate + len] == in[pos + len]) {
+                    len++;
+                }
+
+                if (len >= DEFLATE_MIN_MATCH) {
+                    bestLen = len;
+                    bestDist = pos - candidate;
+                }
+            }
+        }
+
+        if (bestLen != 0) {
+            _putMatch(&bw, bestLen, (uint16_t)bestDist);
+
+            // Index skipped positions so later matches can find them
+            for (size_t i = pos + 1; i < pos + bestLen && i + DEFLATE_MIN_MATCH <= inLen && i < HASH_EMPTY; i++) {
+                head[_hash3(&in[i])] = (uint16_t)i;
+            }
+            pos += bestLen;
+        } else {
+            _putLiteral(&bw, in[pos]);
+            pos++;
+        }
+    }
+
+    _putLiteral(&bw, 256); // End of block
+    _flushBits(&bw);
+
+    _putLE32(&bw, polip_crc32(0, in, inLen));
+    _putLE32(&bw, (uint32_t)inLen);
+
+    return (bw.overflow) ? 0 : bw.pos;
+}
+
+bool polip_gzip_decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outCap, size_t* outLen) {
+    _bit_reader_t br = {in, inLen, 0, NULL, NULL, NULL, out, outCap, 0, 0, 0, false};
+    return _gunzip(&br, outLen);
+}
+
+bool polip_gzip_decompress_stream(polip_gzip_read_t read, void* context, uint8_t* out, size_t outCap, 
+        size_t* outLen) {
+    uint8_t chunk[POLIP_GZIP_STREAM_CHUNK];
+    _bit_reader_t br = {NULL, 0, 0, read, context, chunk, out, outCap, 0, 0, 0, false};
+    return _gunzip(&br, outLen);
+}
+
+uint32_t polip_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ _crcTable[crc & 0x0F];
+        crc = (crc >> 4) ^ _crcTable[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+//==============================================================================
+//  Private Function Implementation - Compress
+//==============================================================================
+
+static void _putBits(_bit_writer_t* bw, uint32_t value, uint8_t count) {
+    bw->bitBuf |= value << bw->bitCnt;
+    bw->bitCnt += count;
+    while (bw->bitCnt >= 8) {
+        _putByte(bw, (uint8_t)bw->bitBuf);
+        bw->bitBuf >>= 8;
+        bw->bitCnt -= 8;
+    }
+}
+
+static void _putHuffman(_bit_writer_t* bw, uint16_t code, uint8_t count) {
+    // Huffman codes are packed most significant bit first
+    uint16_t reversed = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    _putBits(bw, reversed, count);
+}
+
+static void _putLiteral(_bit_writer_t* bw, uint16_t symbol) {
+    if (symbol < 144) {
+        _putHuffman(bw, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        _putHuffman(bw, 0x190 + (symbol - 144), 9);
+    } else if (symbol < 280) {
+        _putHuffman(bw, symbol - 256, 7);
+    } else {
+        _putHuffman(bw, 0xC0 + (symbol - 280), 8);
+    }
+}
+
+static void _putMatch(_bit_writer_t* bw, uint16_t length, uint16_t distance) {
+    int code = 28;
+    while (_lengthBase[code] > length) {
+        code--;
+    }
+    _putLiteral(bw, 257 + code);
+    _putBits(bw, length - _lengthBase[code], _lengthExtra[code]);
+
+    code = 29;
+    while (_distBase[code] > distance) {
+        code--;
+    }
+    _putHuffman(bw, code, 5);
+    _putBits(bw, distance - _distBase[code], _distExtra[code]);
+}
+
+static void _flushBits(_bit_writer_t* bw) {
+    if (bw->bitCnt > 0) {
+        _putByte(bw, (uint8_t)bw->bitBuf);
+    }
+    bw->bitBuf = 0;
+    bw->bitCnt = 0;
+}
+
+static void _putByte(_bit_writer_t* bw, uint8_t byte) {
+    if (bw->pos >= bw->cap) {
+        bw->overflow = true;
+        return;
+    }
+    bw->out[bw->pos++] = byte;
+}
+
+static void _putLE32(_bit_writer_t* bw, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        _putByte(bw, (uint8_t)(value >> (i * 8)));
+    }
+}
+
+static uint16_t _hash3(const uint8_t* p) {
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (uint16_t)(((v * 2654435761UL) >> 16) & (POLIP_COMPRESS_HASH_SIZE - 1));
+}
+
+//==============================================================================
+//  Private Function Implementation - Decompress
+//==============================================================================
+
+static bool _refill(_bit_reader_t* br) {
+    if (br->inPos < br->inLen) {
+        return true;
+    }
+
+    int len = (br->read != NULL) ? br->read(br->context, br->chunk, POLIP_GZIP_STREAM_CHUNK) : 0;
+    if (len <= 0) {
+        br->error = true;
+        return false;
+    }
+
+    br->in = br->chunk;
+    br->inLen = len;
+    br->inPos = 0;
+    return true;
+}
+
+static bool _getByte(_bit_reader_t* br, uint8_t* byte) {
+    if (!_refill(br)) {
+        return false;
+    }
+    *byte = br->in[br->inPos++];
+    return true;
+}
+
+static bool _skipBytes(_bit_reader_t* br, size_t count) {
+    uint8_t byte;
+    while (count-- > 0) {
+        if (!_getByte(br, &byte)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t _getBits(_bit_reader_t* br, uint8_t count) {
+    while (br->bitCnt < count) {
+        if (!_refill(br)) {
+            return 0;
+        }
+        br->bitBuf |= (uint32_t)br->in[br->inPos++] << br->bitCnt;
+        br->bitCnt += 8;
+    }
+
+    uint32_t value = br->bitBuf & ((1UL << count) - 1);
+    br->bitBuf >>= count;
+    br->bitCnt -= count;
+    return value;
+}
+
+static int _decode(_bit_reader_t* br, const _huffman_t* h) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    // Canonical codes of each length are consecutive, walk one bit at a time
+    for (int len = 1; len <= DEFLATE_MAX_BITS; len++) {
+        code |= _getBits(br, 1);
+        int count = h->count[len];
+        if (code - count < first) {
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    br->error = true;
+    return -1;
+}
+
+static bool _construct(_huffman_t* h, const uint8_t* lengths, int n) {
+    uint16_t offsets[DEFLATE_MAX_BITS + 1];
+
+    memset(h->count, 0, sizeof(h->count));
+    for (int s = 0; s < n; s++) {
+        h->count[lengths[s]]++;
+    }
+
+    // Over-subscribed code sets are invalid, incomplete ones are tolerated
+    int left = 1;
+    for (int len = 1; len <= DEFLATE_MAX_BITS; len++) {
+        left = (left << 1) - h->count[len];
+        if (left < 0) {
+            return false;
+        }
+    }
+
+    offsets[1] = 0;
+    for (int len = 1; len < DEFLATE_MAX_BITS; len++) {
+        offsets[len + 1] = offsets[len] + h->count[len];
+    }
+
+    for (int s = 0; s < n; s++) {
+        if (lengths[s] != 0) {
+            h->symbol[offsets[lengths[s]]++] = s;
+        }
+    }
+    return true;
+}
+
+static bool _inflateStored(_bit_reader_t* br) {
+    // Stored blocks start on byte boundary, unread bits are padding
+    br->bitBuf = 0;
+    br->bitCnt = 0;
+
+    uint8_t header[4];
+    for (int i = 0; i < 4; i++) {
+        if (!_getByte(br, &header[i])) {
+            return false;
+        }
+    }
+
+    uint16_t len = header[0] | (header[1] << 8);
+    uint16_t nlen = header[2] | (header[3] << 8);
+    if (len != (uint16_t)~nlen || br->outPos + len > br->outCap) {
+        return false;
+    }
+
+    // Copy as much as each input chunk holds
+    while (len > 0) {
+        if (!_refill(br)) {
+            return false;
+        }
+
+        size_t count = br->inLen - br->inPos;
+        count = (count < len) ? count : len;
+        memcpy(&br->out[br->outPos], &br->in[br->inPos], count);
+        br->inPos += count;
+        br->outPos += count;
+        len -= count;
+    }
+    return true;
+}
+
+static bool _inflateCodes(_bit_reader_t* br, const _huffman_t* lencode, const _huffman_t* distcode) {
+    while (!br->error) {
+        int symbol = _decode(br, lencode);
+        if (symbol < 0) {
+            return false;
+        } else if (symbol < 256) {
+            if (br->outPos >= br->outCap) {
+                return false;
+            }
+            br->out[br->outPos++] = (uint8_t)symbol;
+        } else if (symbol == 256) {
+            return true;
+        } else {
+            symbol -= 257;
+            if (symbol >= 29) {
+                return false;
+            }
+            size_t length = _lengthBase[symbol] + _getBits(br, _lengthExtra[symbol]);
+
+            symbol = _decode(br, distcode);
+            if (symbol < 0 || symbol >= DEFLATE_MAX_DCODES) {
+                return false;
+            }
+            size_t distance = _distBase[symbol] + _getBits(br, _distExtra[symbol]);
+
+            // Output buffer is the window, nothing older is available
+            if (distance > br->outPos || br->outPos + length > br->outCap) {
+                return false;
+            }
+
+            uint8_t* dst = &br->out[br->outPos];
+            const uint8_t* src = dst - distance;
+            for (size_t i = 0; i < length; i++) {
+                dst[i] = src[i]; // May overlap, byte order matters
+            }
+            br->outPos += length;
+        }
+    }
+    return false;
+}
+
+static bool _inflateFixed(_bit_reader_t* br) {
+    uint8_t lengths[DEFLATE_FIX_LCODES];
+    _huffman_t lencode = {{0}, _lenSymbols};
+    _huffman_t distcode = {{0}, _distSymbols};
+
+    int s = 0;
+    for (; s < 144; s++) lengths[s] = 8;
+    for (; s < 256; s++) lengths[s] = 9;
+    for (; s < 280; s++) lengths[s] = 7;
+    for (; s < DEFLATE_FIX_LCODES; s++) lengths[s] = 8;
+    _construct(&lencode, lengths, DEFLATE_FIX_LCODES);
+
+    for (s = 0; s < DEFLATE_MAX_DCODES; s++) lengths[s] = 5;
+    _construct(&distcode, lengths, DEFLATE_MAX_DCODES);
+
+    return _inflateCodes(br, &lencode, &distcode);
+}
+
+static bool _inflateDynamic(_bit_reader_t* br) {
+    uint8_t lengths[DEFLATE_MAX_LCODES + DEFLATE_MAX_DCODES];
+    _huffman_t lencode = {{0}, _lenSymbols};
+    _huffman_t distcode = {{0}, _distSymbols};
+
+    int nlen = _getBits(br, 5) + 257;
+    int ndist = _getBits(br, 5) + 1;
+    int ncode = _getBits(br, 4) + 4;
+    if (br->error || nlen > DEFLATE_MAX_LCODES || ndist > DEFLATE_MAX_DCODES) {
+        return false;
+    }
+
+    // Code length code, borrows length table symbols until read
+    memset(lengths, 0, 19);
+    for (int i = 0; i < ncode; i++) {
+        lengths[_codeLengthOrder[i]] = _getBits(br, 3);
+    }
+    if (br->error || !_construct(&lencode, lengths, 19)) {
+        return false;
+    }
+
+    int index = 0;
+    while (index < nlen + ndist) {
+        int symbol = _decode(br, &lencode);
+        if (symbol < 0) {
+            return false;
+        } else if (symbol < 16) {
+            lengths[index++] = symbol;
+        } else {
+            uint8_t len = 0;
+            int repeat;
+            if (symbol == 16) {
+                if (index == 0) {
+                    return false;
+                }
+                len = lengths[index - 1];
+                repeat = 3 + _getBits(br, 2);
+            } else if (symbol == 17) {
+                repeat = 3 + _getBits(br, 3);
+            } else {
+                repeat = 11 + _getBits(br, 7);
+            }
+
+            if (br->error || index + repeat > nlen + ndist) {
+                return false;
+            }
+            while (repeat--) {
+                lengths[index++] = len;
+            }
+        }
+    }
+
+    if (lengths[256] == 0) {
+        return false; // No end of block code
+    }
+
+    if (!_construct(&lencode, lengths, nlen) || !_construct(&distcode, lengths + nlen, ndist)) {
+        return false;
+    }
+
+    return _inflateCodes(br, &lencode, &distcode);
+}
+
+static bool _inflate(_bit_reader_t* br) {
+    bool last = false;
+    while (!last) {
+        last = _getBits(br, 1);
+        uint32_t type = _getBits(br, 2);
+        if (br->error) {
+            return false;
+        }
+
+        bool ok;
+        switch (type) {
+            case 0: ok = _inflateStored(br); break;
+            case 1: ok = _inflateFixed(br); break;
+            case 2: ok = _inflateDynamic(br); break;
+            default: ok = false; break;
+        }
+
+        if (!ok || br->error) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _gunzip(_bit_reader_t* br, size_t* outLen) {
+    uint8_t header[GZIP_HEADER_SIZE];
+    for (int i = 0; i < GZIP_HEADER_SIZE; i++) {
+        if (!_getByte(br, &header[i])) {
+            return false;
+        }
+    }
+    if (header[0] != 0x1F || header[1] != 0x8B || header[2] != 0x08) {
+        return false;
+    }
+
+    uint8_t flags = header[3];
+    uint8_t byte = 0;
+
+    if (flags & GZIP_FLAG_EXTRA) {
+        uint8_t extraLen[2];
+        if (!_getByte(br, &extraLen[0]) || !_getByte(br, &extraLen[1])
+                || !_skipBytes(br, extraLen[0] | (extraLen[1] << 8))) {
+            return false;
+        }
+    }
+    if (flags & GZIP_FLAG_NAME) {
+        while (_getByte(br, &byte) && byte != 0);
+    }
+    if (flags & GZIP_FLAG_COMMENT) {
+        while (_getByte(br, &byte) && byte != 0);
+    }
+    if (flags & GZIP_FLAG_HCRC) {
+        _skipBytes(br, 2);
+    }
+
+    if (br->error || !_inflate(br)) {
+        return false;
+    }
+
+    // Trailer follows the byte holding the last block's final bit
+    uint8_t trailer[GZIP_TRAILER_SIZE];
+    for (int i = 0; i < GZIP_TRAILER_SIZE; i++) {
+        if (!_getByte(br, &trailer[i])) {
+            return false;
+        }
+    }
+    if (_getLE32(trailer) != polip_crc32(0, br->out, br->outPos)
+            || _getLE32(trailer + 4) != (uint32_t)br->outPos) {
+        return false;
+    }
+
+    *outLen = br->outPos;
+    return true;
+}
+
+static uint32_t _getLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file polip-compress.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Minimal gzip for request and response bodies. The compressor emits a single
+ * fixed Huffman block with greedy LZ77 matching over a bounded window. The
+ * decompressor handles stored, fixed and dynamic blocks and uses its output
+ * buffer as window, so no memory beyond caller buffers and small static
+ * decode tables is needed. Input is taken either from a buffer or pulled from
+ * a stream through a small chunk, so a compressed body need not be held whole.
+ */
+
+#ifndef POLIP_COMPRESS_HPP
+#define POLIP_COMPRESS_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Max match distance searched by compressor (<= 32768)
+#ifndef POLIP_COMPRESS_WINDOW
+#define POLIP_COMPRESS_WINDOW                       (4096)
+#endif
+
+//! Match finder hash table entries (power of 2), 2 bytes each on stack
+#ifndef POLIP_COMPRESS_HASH_SIZE
+#define POLIP_COMPRESS_HASH_SIZE                    (512)
+#endif
+
+//! Request bodies smaller than this are sent uncompressed
+#ifndef POLIP_COMPRESS_DEFAULT_THRESHOLD
+#define POLIP_COMPRESS_DEFAULT_THRESHOLD            (256)
+#endif
+
+//! Stream decompression input chunk, on stack
+#ifndef POLIP_GZIP_STREAM_CHUNK
+#define POLIP_GZIP_STREAM_CHUNK                     (64)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Reads up to len bytes of compressed input into buf
+ * Returns bytes read; 0 or less when input ended or failed
+ */
+typedef int (*polip_gzip_read_t)(void* context, uint8_t* buf, size_t len);
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Compresses buffer into gzip member
+ * 
+ * @param in bytes to compress
+ * @param inLen number of bytes
+ * @param out output buffer
+ * @param outCap capacity of output buffer
+ * @return size_t compressed length; 0 if output does not fit
+ */
+size_t polip_gzip_compress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outCap);
+/**
+ * @brief Decompresses gzip member, checking CRC and length trailer
+ * 
+ * @param in gzip bytes
+ * @param inLen number of bytes
+ * @param out output buffer, also serves as back-reference window
+ * @param outCap capacity of output buffer
+ * @param outLen set to decompressed length on success
+ * @return bool true on success; false if corrupt or output does not fit
+ */
+bool polip_gzip_decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outCap, size_t* outLen);
+/**
+ * @brief Decompresses gzip member pulled from stream, checking CRC and length
+ * trailer. Callback bounds input, a chunk may be read past trailer.
+ * 
+ * @param read callback supplying compressed bytes
+ * @param context passed to callback
+ * @param out output buffer, also serves as back-reference window
+ * @param outCap capacity of output buffer
+ * @param outLen set to decompressed length on success
+ * @return bool true on success; false if corrupt, truncated or output does not fit
+ */
+bool polip_gzip_decompress_stream(polip_gzip_read_t read, void* context, uint8_t* out, size_t outCap, 
+        size_t* outLen);
+/**
+ * @brief Computes CRC-32 (gzip polynomial) incrementally
+ * 
+ * @param crc previous value, 0 to start
+ * @param data bytes to add
+ * @param len number of bytes
+ * @return uint32_t updated CRC
+ */
+uint32_t polip_crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+//==============================================================================
+
+#endif //POLIP_COMPRESS_HPP
\ No newline at end of file
@@ -16,7 +16,7 @@
 //  Preprocessor Constants
 //==============================================================================
 
-//! Allows POLIP lib to print out debug information on serial bus
+//! Enables debug level trace points unless POLIP_TRACE_LEVEL is set explicitly
 #ifndef POLIP_VERBOSE_DEBUG
 #define POLIP_VERBOSE_DEBUG                         (false)
 #endif
@@ -49,7 +49,10 @@ typedef enum _polip_ret_code {
     POLIP_ERROR_LIB_REQUEST,
     POLIP_ERROR_WORKFLOW,
     POLIP_ERROR_MISSING_HOOK,
-    POLIP_ERROR_RPC_SETTING
+    POLIP_ERROR_RPC_SETTING,
+    POLIP_OK_NOT_MODIFIED,          //! Request succeeded, server reports no change since last poll
+    POLIP_ERROR_VALUE_WINDOW_FULL,  //! Too many requests in flight for negotiated value window
+    _POLIP_RET_CODE_COUNT
 } polip_ret_code_t;
 
 /**
@@ -60,7 +63,9 @@ typedef enum _polip_workflow_source {
     POLIP_WORKFLOW_POLL_STATE,
     POLIP_WORKFLOW_GET_VALUE,
     POLIP_WORKFLOW_PUSH_SENSE,
-    POLIP_WORKFLOW_PUSH_RPC
+    POLIP_WORKFLOW_PUSH_RPC,
+    POLIP_WORKFLOW_EXCHANGE,
+    _POLIP_WORKFLOW_SOURCE_COUNT
 } polip_workflow_source_t;
 
 //==============================================================================
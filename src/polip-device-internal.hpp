@@ -0,0 +1,145 @@
+/**
+ * @file polip-device-internal.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib internal device routines shared with sibling modules and 
+ * benchmarks. Not part of the public API, signatures may change.
+ */
+
+#ifndef POLIP_DEVICE_INTERNAL_HPP
+#define POLIP_DEVICE_INTERNAL_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define MIME_JSON                                   "application/json"
+#define MIME_MSGPACK                                "application/msgpack"
+
+//==============================================================================
+//  Internal Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Adds identity, timestamp, value, and tag fields to request document
+ * 
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer containing request body
+ * @param timestamp pointer to formatted timestamp string
+ * @param value message identifier value to send
+ * @param skipValue boolean (default false) omits value field
+ * @param skipTag boolean (default false) omits tag field
+ */
+void _packRequest(polip_device_t* dev, JsonDocument& doc, const char* timestamp, 
+        uint32_t value, bool skipValue = false, bool skipTag = false);
+/**
+ * @brief Serializes document into device buffer using device encoding
+ * 
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer
+ * @return size_t bytes written
+ */
+size_t _serializeRequest(polip_device_t* dev, JsonDocument& doc);
+/**
+ * @brief Computes HMAC tag of document (tag field must be "0") and stores it
+ * in tag field. Uses device buffer as scratch.
+ * 
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer
+ */
+void _computeTag(polip_device_t* dev, JsonDocument& doc);
+/**
+ * @brief Recomputes HMAC tag of received document and compares it against
+ * the tag it arrived with. Leaves recomputed tag in document.
+ * 
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer
+ * @return bool true if tag present and matches
+ */
+bool _verifyTag(polip_device_t* dev, JsonDocument& doc);
+/**
+ * @brief Detects a JSON body where no content type is available. JSON replies
+ * (objects, arrays, error strings) never begin with a MessagePack map marker.
+ * 
+ * @param data response body
+ * @param len length of body
+ * @return bool true if body starts as JSON object, array or string
+ */
+bool _isJsonBody(const char* data, size_t len);
+/**
+ * @brief Verifies a response received outside of the blocking request path
+ * and releases its value
+ * 
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param httpCode HTTP status of response
+ * @param body response body
+ * @param len length of body
+ * @param value value the request was sent with
+ * @param versioned true if request sent state version, only then is 304 accepted
+ * @return polip_ret_code_t same codes as blocking requests
+ */
+polip_ret_code_t _completeRequest(polip_device_t* dev, JsonDocument& doc, int httpCode, 
+        const char* body, size_t len, uint32_t value, bool versioned);
+/**
+ * @brief Whether poll should send state version. Withheld once too many
+ * untagged not-modified replies were accepted in a row, so a full tagged
+ * poll is forced and a spoofed 304 cannot hide state indefinitely.
+ * 
+ * @param dev pointer to device
+ * @return bool true if version should be sent
+ */
+bool _sendStateVersion(polip_device_t* dev);
+/**
+ * @brief Splits server URL into host and port
+ * 
+ * @param url server base URL, e.g. "http://host:3021"
+ * @param host output host name
+ * @param hostSize capacity of host buffer
+ * @param port output port, scheme default (80 / 443) if not specified
+ * @param secure optional output, true for https
+ * @return bool false if host does not fit
+ */
+bool _parseServerUrl(const char* url, char* host, size_t hostSize, uint16_t* port, bool* secure = NULL);
+/**
+ * @brief Base URL requests from device go to
+ * 
+ * @param dev pointer to device
+ * @return const char* active server of linked list, else compile-time URL
+ */
+const char* _serverUrl(polip_device_t* dev);
+/**
+ * @brief GETs health check end-point of a server
+ * 
+ * @param baseUrl server base URL
+ * @param tls optional HTTPS context, https server checked without validation if NULL
+ * @return int HTTP status, negative if unreachable
+ */
+int _healthCheck(const char* baseUrl, struct _polip_tls* tls);
+/**
+ * @brief Converts byte array to lowercase hex string
+ * 
+ * @param array bytes to convert
+ * @param len number of bytes
+ * @param buffer output, must hold len*2 + 1 characters
+ */
+void _array2string(uint8_t array[], unsigned int len, char buffer[]);
+
+//==============================================================================
+
+#endif //POLIP_DEVICE_INTERNAL_HPP
\ No newline at end of file
@@ -17,6 +17,48 @@
 //==============================================================================
 
 #include "./polip-device.hpp"
+#include "./polip-device-internal.hpp"
+#include "./polip-schema.hpp"
+#include "./polip-servers.hpp"
+#include "./polip-tag.hpp"
+#include "./polip-tls.hpp"
+#include "./polip-trace.hpp"
+
+//==============================================================================
+//  Preprocessor Macro Declaration
+//==============================================================================
+
+#define LATENCY_NOT_RUN                             (UINT32_MAX)
+
+#if POLIP_LATENCY_STATS
+
+#define LATENCY_START(name)                                                     \
+    uint32_t name = POLIP_LATENCY_CLOCK()
+
+#define LATENCY_STOP(dev, phase, name) {                                        \
+    if ((dev)->latencyStats != NULL) {                                          \
+        (dev)->latencyStats->_sample[phase] = POLIP_LATENCY_CLOCK() - (name);   \
+    }                                                                           \
+}
+
+#define LATENCY_CLEAR(dev) {                                                    \
+    if ((dev)->latencyStats != NULL) {                                          \
+        for (int _i = 0; _i < _POLIP_LATENCY_PHASE_COUNT; _i++) {               \
+            (dev)->latencyStats->_sample[_i] = LATENCY_NOT_RUN;                 \
+        }                                                                       \
+    }                                                                           \
+}
+
+#define LATENCY_COMMIT(dev, endpointId) _commitLatency(dev, endpointId)
+
+#else
+
+#define LATENCY_START(name)
+#define LATENCY_STOP(dev, phase, name) {}
+#define LATENCY_CLEAR(dev) {}
+#define LATENCY_COMMIT(dev, endpointId) {}
+
+#endif
 
 //==============================================================================
 //  Data Structure Declaration
@@ -30,32 +72,42 @@ typedef struct _ret {
     bool jsonCode;                      //! Serializer status on deserialization
 } _ret_t;
 
+/**
+ * Response body left on socket, bounds streamed decompression
+ */
+typedef struct _body_reader {
+    WiFiClient* stream;
+    size_t remaining;
+} _body_reader_t;
+
 //==============================================================================
 //  Private Function Prototypes
 //==============================================================================
 
 static polip_ret_code_t _requestTemplate(polip_device_t* dev, JsonDocument& doc, 
-        const char* timestamp, const char* endpoint, bool skipValue = false, 
-        bool skipTag = false);
-static void _packRequest(polip_device_t* dev, JsonDocument& doc, 
-        const char* timestamp, bool skipValue = false, bool skipTag = false);
+        const char* timestamp, const char* endpoint, polip_endpoint_t endpointId, 
+        bool skipValue = false, bool skipTag = false, bool allowResync = true);
+static polip_ret_code_t _resyncAndReplay(polip_device_t* dev, JsonDocument& doc, 
+        const char* timestamp, const char* endpoint, polip_endpoint_t endpointId, bool skipTag);
+static polip_ret_code_t _checkResponse(polip_device_t* dev, JsonDocument& doc, 
+        _ret_t ret, uint32_t value, bool skipValue, bool skipTag, bool versioned);
 static _ret_t _sendPostRequest(polip_device_t* dev, JsonDocument& doc, const char* endpoint);
-static void _computeTag(polip_device_t* dev, JsonDocument& doc);
-static void _array2string(uint8_t array[], unsigned int len, char buffer[]);
+static _ret_t _sendTransportRequest(polip_device_t* dev, JsonDocument& doc, const char* endpoint);
+static int _readBody(void* context, uint8_t* buf, size_t len);
+static int _healthCheckClient(const char* baseUrl, WiFiClient* client);
+static void _capturePayload(polip_device_t* dev, const char* direction, const char* data, size_t len);
+static void _dropConnection(polip_device_t* dev);
+static void _persistValue(polip_device_t* dev, bool force = false);
+#if POLIP_LATENCY_STATS
+static void _commitLatency(polip_device_t* dev, polip_endpoint_t endpointId);
+#endif
 
 //==============================================================================
 //  Public Function Implementation
 //==============================================================================
 
-polip_ret_code_t polip_checkServerStatus() {
-
-    WiFiClient client;
-    HTTPClient http;
-
-    http.begin(client, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/health/check");
-    int code = http.GET();
-    http.end();
-
+polip_ret_code_t polip_checkServerStatus(polip_tls_t* tls) {
+    int code = _healthCheck(POLIP_DEVICE_INGEST_SERVER_URL, tls);
     return (code == 200) ? POLIP_OK : POLIP_ERROR_SERVER_ERROR;
 }
 
@@ -63,27 +115,39 @@ polip_ret_code_t polip_getState(polip_device_t* dev, JsonDocument& doc, const ch
         bool queryState, bool queryManufacturer, bool queryRPC) {
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/poll" "?state=%s&manufacturer=%s&rpc=%s",
+    int len = sprintf(uri, "%s/api/device/v1/poll" "?state=%s&manufacturer=%s&rpc=%s", _serverUrl(dev),
         (queryState) ? "true" : "false",
         (queryManufacturer) ? "true" : "false",
         (queryRPC) ? "true" : "false"
     );
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    if (_sendStateVersion(dev)) {
+        // Server can short-circuit with not-modified if nothing changed since
+        sprintf(uri + len, "&version=%lu", (unsigned long)dev->stateVersion);
+    }
+
+    polip_ret_code_t status = _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_POLL);
+
+    if (status == POLIP_OK) {
+        dev->stateVersion = doc["version"]; // Absent if server does not version state
+        dev->_notModified = 0;
+    }
+
+    return status;
 }
 
 polip_ret_code_t polip_getMeta(polip_device_t* dev, JsonDocument& doc, const char* timestamp,
         bool queryState, bool querySensors, bool queryManufacturer, bool queryGeneral) {
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/meta" "?state=%s&manufacturer=%s&sensors=%s&general=%s",
+    sprintf(uri, "%s/api/device/v1/meta" "?state=%s&manufacturer=%s&sensors=%s&general=%s", _serverUrl(dev),
         (queryState) ? "true" : "false",
         (queryManufacturer) ? "true" : "false",
         (querySensors) ? "true" : "false",
         (queryGeneral) ? "true" : "false"
     );
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_META);
 }
 
 polip_ret_code_t polip_pushState(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
@@ -92,9 +156,9 @@ polip_ret_code_t polip_pushState(polip_device_t* dev, JsonDocument& doc, const c
     }
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/state");
+    sprintf(uri, "%s/api/device/v1/state", _serverUrl(dev));
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_STATE);
 }
 
 polip_ret_code_t polip_pushError(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
@@ -103,9 +167,9 @@ polip_ret_code_t polip_pushError(polip_device_t* dev, JsonDocument& doc, const c
     }
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/error");
+    sprintf(uri, "%s/api/device/v1/error", _serverUrl(dev));
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_ERROR);
 }
 
 polip_ret_code_t polip_pushSensors(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
@@ -114,27 +178,130 @@ polip_ret_code_t polip_pushSensors(polip_device_t* dev, JsonDocument& doc, const
     }
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/sense");
+    sprintf(uri, "%s/api/device/v1/sense", _serverUrl(dev));
+
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_SENSE);
+}
+
+polip_ret_code_t polip_exchange(polip_device_t* dev, JsonDocument& doc, const char* timestamp, bool poll,
+        bool queryState, bool queryManufacturer, bool queryRPC) {
+    if (!poll && !doc.containsKey("state") && !doc.containsKey("sense")) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    char uri[POLIP_QUERY_URI_BUFFER_SIZE];
+    sprintf(uri, "%s/api/device/v1/exchange" "?poll=%s&state=%s&manufacturer=%s&rpc=%s", _serverUrl(dev),
+        (poll) ? "true" : "false",
+        (poll && queryState) ? "true" : "false",
+        (poll && queryManufacturer) ? "true" : "false",
+        (poll && queryRPC) ? "true" : "false"
+    );
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_EXCHANGE);
 }
 
 polip_ret_code_t polip_getValue(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/device/v1/value");
+    sprintf(uri, "%s/api/device/v1/value", _serverUrl(dev));
 
-    polip_ret_code_t status = _requestTemplate(dev, doc, timestamp, uri,
+    if (POLIP_MAX_VALUE_WINDOW > 1) {
+        doc["window"] = POLIP_MAX_VALUE_WINDOW; // Server may grant up to this many
+    }
+
+    polip_ret_code_t status = _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_VALUE,
         true, // skip value in request pack 
         true  // skip tag in request pack, response check
     );
 
     if (status == POLIP_OK) {
         dev->value = doc["value"];
+        unsigned int window = doc["window"] | 1; // Absent if server is strict
+        dev->valueWindow = (window > POLIP_MAX_VALUE_WINDOW) ? POLIP_MAX_VALUE_WINDOW : window;
+        dev->_valueBase = dev->value;
+        dev->_valueInFlight = 0;
+        _persistValue(dev, true);
     }
     
     return status;
 }
 
+polip_ret_code_t polip_restoreValue(polip_device_t* dev) {
+    if (dev->loadValueCb == NULL) {
+        return POLIP_ERROR_MISSING_HOOK;
+    }
+
+    uint32_t value = 0;
+    uint8_t window = 1;
+    if (!dev->loadValueCb(dev, &value, &window)) {
+        return POLIP_ERROR_WORKFLOW; // Nothing stored, will resync with server
+    }
+
+    // Stored value is at or ahead of last used, so can be sent without resync
+    dev->value = value;
+    dev->valueWindow = (window > POLIP_MAX_VALUE_WINDOW) ? POLIP_MAX_VALUE_WINDOW : window;
+    dev->_valueBase = value;
+    dev->_valueInFlight = 0;
+    dev->_valuePersisted = value;
+
+    return POLIP_OK;
+}
+
+polip_ret_code_t polip_reserveValue(polip_device_t* dev, uint32_t* value) {
+    if (dev->valueWindow <= 1) {
+        *value = dev->value; // Strict, advanced once acknowledged
+        return POLIP_OK;
+    } else if (dev->value - dev->_valueBase >= dev->valueWindow) {
+        return POLIP_ERROR_VALUE_WINDOW_FULL;
+    }
+
+    *value = dev->value;
+    dev->_valueInFlight |= (1UL << (dev->value - dev->_valueBase));
+    dev->value += 1;
+    _persistValue(dev);
+    return POLIP_OK;
+}
+
+void polip_releaseValue(polip_device_t* dev, uint32_t value, bool acknowledged) {
+    if (dev->valueWindow <= 1) {
+        if (acknowledged && value == dev->value) {
+            dev->value += 1;
+            _persistValue(dev);
+        }
+        return;
+    } else if (value - dev->_valueBase >= dev->valueWindow) {
+        return; // Not in window, stale after resync
+    }
+
+    // Value is consumed either way, slide base past oldest completed values
+    dev->_valueInFlight &= ~(1UL << (value - dev->_valueBase));
+    while (dev->_valueBase != dev->value && (dev->_valueInFlight & 1UL) == 0) {
+        dev->_valueBase += 1;
+        dev->_valueInFlight >>= 1;
+    }
+}
+
+const polip_latency_endpoint_t* polip_getLatencyStats(polip_device_t* dev, polip_endpoint_t endpoint) {
+    if (dev->latencyStats == NULL || endpoint >= _POLIP_ENDPOINT_COUNT) {
+        return NULL;
+    }
+    return &dev->latencyStats->endpoints[endpoint];
+}
+
+void polip_resetLatencyStats(polip_device_t* dev) {
+    if (dev->latencyStats == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < _POLIP_ENDPOINT_COUNT; i++) {
+        polip_latency_endpoint_t* entry = &dev->latencyStats->endpoints[i];
+        for (int j = 0; j < _POLIP_LATENCY_PHASE_COUNT; j++) {
+            polip_stat_reset(&entry->phases[j]);
+        }
+        polip_stat_reset(&entry->total);
+        polip_histogram_reset(&entry->histogram);
+    }
+}
+
 polip_ret_code_t polip_pushRPC(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
     if (!doc.containsKey("rpc")) {
         return POLIP_ERROR_LIB_REQUEST;
@@ -152,30 +319,30 @@ polip_ret_code_t polip_pushRPC(polip_device_t* dev, JsonDocument& doc, const cha
     }
 
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/v1/device/rpc");
+    sprintf(uri, "%s/api/v1/device/rpc", _serverUrl(dev));
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_RPC);
 }
 
 polip_ret_code_t polip_getSchema(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/v1/device/schema");
+    sprintf(uri, "%s/api/v1/device/schema", _serverUrl(dev));
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_SCHEMA);
 }
 
 polip_ret_code_t polip_getAllErrorSemantics(polip_device_t* dev, JsonDocument& doc, const char* timestamp) {
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/v1/device/error/semantic");
+    sprintf(uri, "%s/api/v1/device/error/semantic", _serverUrl(dev));
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_ERROR_SEMANTIC);
 }
 
 polip_ret_code_t polip_getErrorSemanticFromCode(polip_device_t* dev, int32_t code, JsonDocument& doc, const char* timestamp) {
     char uri[POLIP_QUERY_URI_BUFFER_SIZE];
-    sprintf(uri, POLIP_DEVICE_INGEST_SERVER_URL "/api/v1/device/error/semantic" "?code=%d", code);
+    sprintf(uri, "%s/api/v1/device/error/semantic" "?code=%d", _serverUrl(dev), code);
 
-    return _requestTemplate(dev, doc, timestamp, uri);
+    return _requestTemplate(dev, doc, timestamp, uri, POLIP_ENDPOINT_ERROR_SEMANTIC);
 }
 
 //==============================================================================
@@ -183,9 +350,76 @@ polip_ret_code_t polip_getErrorSemanticFromCode(polip_device_t* dev, int32_t cod
 //==============================================================================
 
 static polip_ret_code_t _requestTemplate(polip_device_t* dev, JsonDocument& doc, 
-        const char* timestamp, const char* endpoint, bool skipValue, bool skipTag) {
-    _packRequest(dev, doc, timestamp, skipValue, skipTag);
+        const char* timestamp, const char* endpoint, polip_endpoint_t endpointId, 
+        bool skipValue, bool skipTag, bool allowResync) {
+    if (dev->_busy) {
+        // Called from a callback / yield while this device is mid-request,
+        //  sending now would interleave values and share its buffer
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    uint32_t value = 0;
+    if (!skipValue && polip_reserveValue(dev, &value) != POLIP_OK) {
+        return POLIP_ERROR_VALUE_WINDOW_FULL;
+    }
+
+    dev->_busy = true;
+
+    LATENCY_CLEAR(dev);
+    LATENCY_START(packStart);
+    if (dev->schemaDict != NULL) {
+        polip_schema_compact(dev->schemaDict, doc);
+    }
+    _packRequest(dev, doc, timestamp, value, skipValue, skipTag);
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_PACK, packStart);
+
+    unsigned long exchangeStart = millis();
     _ret_t ret = _sendPostRequest(dev, doc, endpoint);
+    if (dev->servers != NULL && dev->transport == NULL) {
+        // 4xx would be the same on any server, only unreachable / 5xx count against it
+        bool ok = (ret.httpCode > 0 && ret.httpCode < 500);
+        if (polip_server_list_record(dev->servers, ok, millis() - exchangeStart, millis())) {
+            _dropConnection(dev); // Kept-alive socket belongs to old server
+        }
+    }
+
+    // Only a poll that sent its state version can be answered not-modified
+    bool versioned = (endpointId == POLIP_ENDPOINT_POLL && strstr(endpoint, "&version=") != NULL);
+
+    LATENCY_START(verifyStart);
+    polip_ret_code_t status = _checkResponse(dev, doc, ret, value, skipValue, skipTag, versioned);
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_VERIFY, verifyStart);
+    LATENCY_COMMIT(dev, endpointId);
+
+    if (!skipValue) {
+        polip_releaseValue(dev, value, (status == POLIP_OK || status == POLIP_OK_NOT_MODIFIED));
+    }
+
+    dev->_busy = false;
+
+    if (status == POLIP_ERROR_VALUE_MISMATCH && allowResync && !skipValue && dev->resyncValue) {
+        return _resyncAndReplay(dev, doc, timestamp, endpoint, endpointId, skipTag);
+    }
+
+    return status; // Document updates returned by reference
+}
+
+static polip_ret_code_t _checkResponse(polip_device_t* dev, JsonDocument& doc, 
+        _ret_t ret, uint32_t value, bool skipValue, bool skipTag, bool versioned) {
+
+    if (ret.httpCode == 304) {
+        // Not modified carries no body to verify, so only trusted a bounded number of times
+        //  and never as the reply to a push, which would acknowledge its value unauthenticated
+        if (!versioned || dev->_notModified >= dev->maxNotModified) {
+            return POLIP_ERROR_SERVER_ERROR; // Version was withheld, server had no reason to send it
+        }
+        dev->_notModified++;
+        return POLIP_OK_NOT_MODIFIED;
+    }
+
+    if (ret.httpCode <= 0) {
+        return POLIP_ERROR_SERVER_ERROR; // Unreachable or timed out, nothing to parse
+    }
 
     if (ret.jsonCode) {
         return POLIP_ERROR_RESPONSE_DESERIALIZATION;
@@ -200,25 +434,330 @@ static polip_ret_code_t _requestTemplate(polip_device_t* dev, JsonDocument& doc,
         }
     }
 
-    if (!skipTag && !dev->skipTagCheck) {
-        const char* oldTag = doc["tag"];
-        doc["tag"] = "0";
-        _computeTag(dev, doc);
+    if (!skipTag && !dev->skipTagCheck && !_verifyTag(dev, doc)) {
+        return POLIP_ERROR_TAG_MISMATCH;
+    }
+
+    if (!skipValue && dev->valueWindow > 1 && doc.containsKey("value")
+            && doc["value"].as<uint32_t>() != value) {
+        return POLIP_ERROR_SERVER_ERROR; // Response belongs to another request
+    }
+
+    return POLIP_OK;
+}
+
+static polip_ret_code_t _resyncAndReplay(polip_device_t* dev, JsonDocument& doc, 
+        const char* timestamp, const char* endpoint, polip_endpoint_t endpointId, bool skipTag) {
+
+    dev->valueResyncs++;
+
+    // Restore failed request from transmit buffer before value request reuses it
+    doc.clear();
+    DeserializationError err = (dev->encoding == POLIP_ENCODING_MSGPACK)
+        ? deserializeMsgPack(doc, (const char*)dev->buffer, (size_t)dev->bufferLen)
+        : deserializeJson(doc, (const char*)dev->buffer);
+    if (err) {
+        return POLIP_ERROR_VALUE_MISMATCH;
+    }
+
+    StaticJsonDocument<POLIP_VALUE_DOC_SIZE> valueDoc;
+    if (polip_getValue(dev, valueDoc, timestamp) != POLIP_OK) {
+        return POLIP_ERROR_VALUE_MISMATCH;
+    }
+
+    // Re-tag with new value and replay, only once
+    return _requestTemplate(dev, doc, timestamp, endpoint, endpointId, false, skipTag, false);
+}
+
+static _ret_t _sendPostRequest(polip_device_t* dev, JsonDocument& doc, const char* endpoint) {
+    if (dev->transport != NULL) {
+        return _sendTransportRequest(dev, doc, endpoint);
+    }
+
+    _ret_t retVal;
+    polip_dns_client_t localClient;
+    HTTPClient localHttp;
+    WiFiClient* client = &localClient;
+    HTTPClient* http = &localHttp;
+
+    localClient.cache = dev->dnsCache;
+    if (dev->connection != NULL) {
+        // Linked connection keeps socket open across requests
+        dev->connection->client.cache = dev->dnsCache;
+        client = &dev->connection->client;
+        http = &dev->connection->http;
+        http->setReuse(true);
+        http->setTimeout(dev->connection->timeout_ms);
+        client->setTimeout(dev->connection->timeout_ms);
+        dev->connection->requests++;
+    }
 
-        if (0 != strcmp(oldTag, doc["tag"])) { // Tag match failed
-            return POLIP_ERROR_TAG_MISMATCH;   
+    if (dev->tls != NULL) {
+        client = &dev->tls->client; // Reconnects resume cached session
+        if (dev->connection != NULL) {
+            client->setTimeout(dev->connection->timeout_ms);
         }
     }
 
-    if (!skipValue) {
-        dev->value += 1;
+    static const char* responseHeaders[] = {"Content-Type", "Content-Encoding"};
+    bool msgpack = (dev->encoding == POLIP_ENCODING_MSGPACK);
+    bool gzip = (dev->zBuffer != NULL);
+
+    http->begin(*client, endpoint);
+    http->addHeader("Content-Type", (msgpack) ? MIME_MSGPACK : MIME_JSON);
+    if (msgpack) {
+        http->addHeader("Accept", MIME_MSGPACK);
+    }
+    if (gzip) {
+        http->addHeader("Accept-Encoding", "gzip");
+    }
+    if (msgpack || gzip) {
+        http->collectHeaders(responseHeaders, 2);
+    }
+
+    LATENCY_START(serializeStart);
+    size_t txLen = _serializeRequest(dev, doc);
+    const uint8_t* body = (const uint8_t*)dev->buffer;
+    size_t bodyLen = txLen;
+    if (gzip && txLen >= dev->compressThreshold) {
+        // Tag covers uncompressed body, server inflates before verifying
+        size_t zLen = polip_gzip_compress(body, txLen, (uint8_t*)dev->zBuffer, dev->zBufferLen);
+        if (zLen != 0 && zLen < txLen) {
+            http->addHeader("Content-Encoding", "gzip");
+            body = (const uint8_t*)dev->zBuffer;
+            bodyLen = zLen;
+        }
     }
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_SERIALIZE, serializeStart);
+
+    if (dev->debugMode) {
+        POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_DEVICE, POLIP_TRACE_REQUEST_TX, txLen);
+        _capturePayload(dev, "TX", dev->buffer, txLen);
+    }
+
+    LATENCY_START(exchangeStart);
+    retVal.httpCode = http->POST((uint8_t*)body, bodyLen);
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_EXCHANGE, exchangeStart);
+
+    doc.clear();
+    if (retVal.httpCode == 304) {
+        retVal.jsonCode = false; // Not modified replies carry no body
+    } else {
+        LATENCY_START(receiveStart);
+        String payload;
+        const char* rxData = NULL;
+        size_t rxLen = 0;
+        bool zBody = gzip && http->header("Content-Encoding").equals("gzip");
+        int bodySize = http->getSize();
+
+        // Inflate into scratch so transmit buffer still holds request for replay
+        if (zBody && bodySize > 0) {
+            // Pulled from socket in small chunks, compressed body is never held whole
+            _body_reader_t reader = {http->getStreamPtr(), (size_t)bodySize};
+            if (!polip_gzip_decompress_stream(_readBody, &reader, (uint8_t*)dev->zBuffer, dev->zBufferLen, &rxLen)) {
+                rxLen = 0; // Corrupt or too large, fails deserialization below
+            }
+            if (reader.remaining > 0) {
+                _dropConnection(dev); // Unread body would be taken as next reply
+            }
+            rxData = dev->zBuffer;
+        } else {
+            // Chunked transfer has no length to bound socket reads, buffer it whole
+            payload = http->getString();
+            rxData = payload.c_str();
+            rxLen = payload.length();
+            if (zBody) {
+                if (!polip_gzip_decompress((const uint8_t*)rxData, rxLen, (uint8_t*)dev->zBuffer, dev->zBufferLen, &rxLen)) {
+                    rxLen = 0;
+                }
+                rxData = dev->zBuffer;
+            }
+        }
+        LATENCY_STOP(dev, POLIP_LATENCY_PHASE_RECEIVE, receiveStart);
 
-    return POLIP_OK; // Document updates returned by reference
+        if (dev->debugMode) {
+            _capturePayload(dev, "RX", rxData, rxLen);
+        }
+
+        // Decoder follows what server sent, error replies may be JSON whatever was asked
+        bool msgpackBody = msgpack && http->header("Content-Type").indexOf(MIME_MSGPACK) >= 0;
+        if (msgpack && (retVal.httpCode == 415 || (retVal.httpCode == 200 && !msgpackBody))) {
+            // Server rejected body or ignored Accept, it does not speak MessagePack
+            dev->encoding = POLIP_ENCODING_JSON;
+        }
+
+        LATENCY_START(deserializeStart);
+        retVal.jsonCode = (msgpackBody) 
+            ? deserializeMsgPack(doc, rxData, rxLen)
+            : deserializeJson(doc, rxData, rxLen);
+        LATENCY_STOP(dev, POLIP_LATENCY_PHASE_DESERIALIZE, deserializeStart);
+    }
+
+    if (dev->debugMode) {
+        POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_DEVICE, POLIP_TRACE_REQUEST_RX, retVal.httpCode);
+    }
+
+    http->end();
+
+    return retVal;
 }
 
-static void _packRequest(polip_device_t* dev, JsonDocument& doc, const char* timestamp, 
-        bool skipValue, bool skipTag) {
+static _ret_t _sendTransportRequest(polip_device_t* dev, JsonDocument& doc, const char* endpoint) {
+    _ret_t retVal;
+
+    // Transports address endpoints by path, server base URL is HTTP only
+    const char* path = strstr(endpoint, "/api/");
+    if (path == NULL) {
+        path = endpoint;
+    }
+
+    LATENCY_START(serializeStart);
+    size_t txLen = _serializeRequest(dev, doc);
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_SERIALIZE, serializeStart);
+
+    if (dev->debugMode) {
+        POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_DEVICE, POLIP_TRACE_REQUEST_TX, txLen);
+        _capturePayload(dev, "TX", dev->buffer, txLen);
+    }
+
+    const char* rxData = NULL;
+    size_t rxLen = 0;
+    LATENCY_START(exchangeStart);
+    retVal.httpCode = dev->transport->exchange(dev->transport->context, dev, path, 
+        (const uint8_t*)dev->buffer, txLen, &rxData, &rxLen);
+    LATENCY_STOP(dev, POLIP_LATENCY_PHASE_EXCHANGE, exchangeStart);
+
+    doc.clear();
+    if (retVal.httpCode == 304 || rxData == NULL) {
+        retVal.jsonCode = false; // No body, negative codes surface as server error
+    } else {
+        if (dev->debugMode) {
+            _capturePayload(dev, "RX", rxData, rxLen);
+        }
+
+        // No content type over transports, but JSON replies cannot start like a MessagePack map
+        bool msgpack = (dev->encoding == POLIP_ENCODING_MSGPACK);
+        bool msgpackBody = msgpack && !_isJsonBody(rxData, rxLen);
+        if (msgpack && (retVal.httpCode == 415 || (retVal.httpCode == 200 && !msgpackBody))) {
+            dev->encoding = POLIP_ENCODING_JSON;
+        }
+
+        LATENCY_START(deserializeStart);
+        retVal.jsonCode = (msgpackBody) 
+            ? deserializeMsgPack(doc, rxData, rxLen)
+            : deserializeJson(doc, rxData, rxLen);
+        LATENCY_STOP(dev, POLIP_LATENCY_PHASE_DESERIALIZE, deserializeStart);
+    }
+
+    if (dev->debugMode) {
+        POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_DEVICE, POLIP_TRACE_REQUEST_RX, retVal.httpCode);
+    }
+
+    return retVal;
+}
+
+static int _healthCheckClient(const char* baseUrl, WiFiClient* client) {
+    char uri[POLIP_QUERY_URI_BUFFER_SIZE];
+    HTTPClient http;
+
+    snprintf(uri, sizeof(uri), "%s/api/device/v1/health/check", baseUrl);
+    http.begin(*client, uri);
+    int code = http.GET();
+    http.end();
+
+    return code;
+}
+
+static int _readBody(void* context, uint8_t* buf, size_t len) {
+    _body_reader_t* reader = (_body_reader_t*)context;
+    if (reader->stream == NULL || reader->remaining == 0) {
+        return 0;
+    }
+
+    // Waits up to socket timeout for bytes still in flight
+    size_t count = reader->stream->readBytes(buf, (len < reader->remaining) ? len : reader->remaining);
+    reader->remaining -= count;
+    return count;
+}
+
+static void _capturePayload(polip_device_t* dev, const char* direction, const char* data, size_t len) {
+    if (dev->debugSink == NULL) {
+        return;
+    }
+
+    // Raw bytes as sent / received, truncated so capture cost stays bounded
+    dev->debugSink->print(direction);
+    dev->debugSink->print(' ');
+    dev->debugSink->print((unsigned long)len);
+    dev->debugSink->print(' ');
+    dev->debugSink->write((const uint8_t*)data, (len > dev->debugCaptureLen) ? dev->debugCaptureLen : len);
+    dev->debugSink->println();
+}
+
+static void _dropConnection(polip_device_t* dev) {
+    if (dev->connection != NULL) {
+        dev->connection->http.end();
+        dev->connection->client.stop();
+    }
+    if (dev->tls != NULL) {
+        dev->tls->client.stop();
+    }
+}
+
+static void _persistValue(polip_device_t* dev, bool force) {
+    if (dev->saveValueCb == NULL || (!force && dev->value <= dev->_valuePersisted)) {
+        return; // Next value still covered by what is stored
+    }
+
+    // Windowed: reserve ahead so storage is written once per block rather than
+    //  per request, never beyond what the window tolerates after a reboot.
+    //  Strict: server accepts only the exact next value, anything ahead would resync
+    uint32_t ahead = 0;
+    if (dev->valueWindow > 1) {
+        ahead = POLIP_VALUE_PERSIST_AHEAD;
+        if (ahead > (uint32_t)dev->valueWindow - 1) {
+            ahead = dev->valueWindow - 1;
+        }
+    }
+
+    if (dev->saveValueCb(dev, dev->value + ahead, dev->valueWindow)) {
+        dev->_valuePersisted = dev->value + ahead;
+    }
+}
+
+#if POLIP_LATENCY_STATS
+static void _commitLatency(polip_device_t* dev, polip_endpoint_t endpointId) {
+    static const uint32_t bounds[POLIP_STATS_HIST_BUCKETS - 1] = POLIP_LATENCY_HIST_BOUNDS;
+
+    if (dev->latencyStats == NULL) {
+        return;
+    }
+
+    uint32_t* sample = dev->latencyStats->_sample;
+    if (sample[POLIP_LATENCY_PHASE_PACK] != LATENCY_NOT_RUN && sample[POLIP_LATENCY_PHASE_TAG] != LATENCY_NOT_RUN) {
+        sample[POLIP_LATENCY_PHASE_PACK] -= sample[POLIP_LATENCY_PHASE_TAG]; // Tag timed within pack
+    }
+
+    polip_latency_endpoint_t* entry = &dev->latencyStats->endpoints[endpointId];
+    uint32_t total = 0;
+    for (int i = 0; i < _POLIP_LATENCY_PHASE_COUNT; i++) {
+        if (sample[i] != LATENCY_NOT_RUN) {
+            polip_stat_record(&entry->phases[i], sample[i]);
+            total += sample[i];
+        }
+    }
+
+    polip_stat_record(&entry->total, total);
+    polip_histogram_record(&entry->histogram, bounds, total);
+}
+#endif
+
+//==============================================================================
+//  Internal Function Implementation
+//==============================================================================
+
+void _packRequest(polip_device_t* dev, JsonDocument& doc, const char* timestamp, 
+        uint32_t value, bool skipValue, bool skipTag) {
 
     doc["serial"] = dev->serialStr; 
     doc["firmware"] = dev->firmwareStr;
@@ -226,65 +765,126 @@ static void _packRequest(polip_device_t* dev, JsonDocument& doc, const char* tim
     doc["timestamp"] = timestamp;
 
     if (!skipValue) {
-        doc["value"] = dev->value;
+        doc["value"] = value;
     }
 
     if (!skipTag) {
         doc["tag"] = "0";
         if (!dev->skipTagCheck) {
+            LATENCY_START(tagStart);
             _computeTag(dev, doc);
+            LATENCY_STOP(dev, POLIP_LATENCY_PHASE_TAG, tagStart);
         }
     }
 }
 
-static _ret_t _sendPostRequest(polip_device_t* dev, JsonDocument& doc, const char* endpoint) {
-    _ret_t retVal;
-    WiFiClient client;
-    HTTPClient http;
+size_t _serializeRequest(polip_device_t* dev, JsonDocument& doc) {
+    if (dev->encoding == POLIP_ENCODING_MSGPACK) {
+        return serializeMsgPack(doc, dev->buffer, (size_t)dev->bufferLen);
+    }
+    return serializeJson(doc, dev->buffer, (size_t)dev->bufferLen);
+}
+
+void _computeTag(polip_device_t* dev, JsonDocument& doc) {
+    polip_tag_job_t job;
+    job.dev = dev;
+    job.msg = dev->buffer;
+    job.len = _serializeRequest(dev, doc);
+    polip_tag_compute_batch(&job, 1);
 
-    http.begin(client, endpoint);
-    http.addHeader("Content-Type", "application/json");
+    doc["tag"] = job.tag;
+}
 
-    serializeJson(doc, dev->buffer, (size_t)dev->bufferLen);
+const char* _serverUrl(polip_device_t* dev) {
+    return (dev->servers != NULL) ? POLIP_SERVERS_ACTIVE_URL(dev->servers) : POLIP_DEVICE_INGEST_SERVER_URL;
+}
 
-    if (dev->debugMode || POLIP_VERBOSE_DEBUG) {
-        Serial.print("Endpoint: ");
-        Serial.println(endpoint);
-        Serial.print("TX = ");
-        Serial.println(dev->buffer);
+int _healthCheck(const char* baseUrl, polip_tls_t* tls) {
+    if (tls != NULL) {
+        return _healthCheckClient(baseUrl, &tls->client);
+    } else if (strncmp(baseUrl, "https:", 6) == 0) {
+        // Built only when needed, TLS client is large and plain checks never use it
+        BearSSL::WiFiClientSecure insecureClient;
+        insecureClient.setInsecure(); // Check carries no device data
+        return _healthCheckClient(baseUrl, &insecureClient);
     }
 
-    retVal.httpCode = http.POST((char*)(dev->buffer));
+    WiFiClient plainClient;
+    return _healthCheckClient(baseUrl, &plainClient);
+}
 
-    doc.clear();
-    retVal.jsonCode = deserializeJson(doc, http.getString());
+bool _verifyTag(polip_device_t* dev, JsonDocument& doc) {
+    const char* oldTag = doc["tag"];
+    if (oldTag == NULL) {
+        return false;
+    }
+
+    doc["tag"] = "0";
+    _computeTag(dev, doc);
+
+    return (0 == strcmp(oldTag, doc["tag"]));
+}
+
+polip_ret_code_t _completeRequest(polip_device_t* dev, JsonDocument& doc, int httpCode, 
+        const char* body, size_t len, uint32_t value, bool versioned) {
+    _ret_t ret;
+    ret.httpCode = httpCode;
 
-    if (dev->debugMode || POLIP_VERBOSE_DEBUG) {
-        serializeJson(doc, dev->buffer, (size_t)dev->bufferLen);
-        Serial.print("RX = ");
-        Serial.println(dev->buffer);
+    doc.clear();
+    if (httpCode == 304) {
+        ret.jsonCode = false;
+    } else {
+        // No content type parsed here, body is sniffed as on transport path
+        bool msgpack = (dev->encoding == POLIP_ENCODING_MSGPACK);
+        bool msgpackBody = msgpack && !_isJsonBody(body, len);
+        if (msgpack && (httpCode == 415 || (httpCode == 200 && !msgpackBody))) {
+            dev->encoding = POLIP_ENCODING_JSON;
+        }
+        ret.jsonCode = (msgpackBody) 
+            ? (bool)deserializeMsgPack(doc, body, len)
+            : (bool)deserializeJson(doc, body, len);
     }
 
-    http.end();
+    polip_ret_code_t status = _checkResponse(dev, doc, ret, value, false, false, versioned);
+    polip_releaseValue(dev, value, (status == POLIP_OK || status == POLIP_OK_NOT_MODIFIED));
+    return status;
+}
 
-    return retVal;
+bool _isJsonBody(const char* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            return c == '{' || c == '[' || c == '"';
+        }
+    }
+    return false;
 }
 
-static void _computeTag(polip_device_t* dev, JsonDocument& doc) {
-    SHA256HMAC hmac(dev->keyStr, dev->keyStrLen);
-    serializeJson(doc, dev->buffer, (size_t)dev->bufferLen);
-    hmac.doUpdate(dev->buffer);
+bool _sendStateVersion(polip_device_t* dev) {
+    return dev->stateVersion != 0 && dev->_notModified < dev->maxNotModified;
+}
 
-    uint8_t authCode[SHA256HMAC_SIZE];
-    hmac.doFinal(authCode);
+bool _parseServerUrl(const char* url, char* host, size_t hostSize, uint16_t* port, bool* secure) {
+    bool https = (strncmp(url, "https:", 6) == 0);
+    if (secure != NULL) {
+        *secure = https;
+    }
+
+    const char* start = strstr(url, "://");
+    start = (start != NULL) ? start + 3 : url;
 
-    char authStr[SHA256HMAC_SIZE*2 + 1];
-    _array2string(authCode, SHA256HMAC_SIZE, authStr);
+    size_t len = strcspn(start, ":/");
+    if (len == 0 || len >= hostSize) {
+        return false;
+    }
+    memcpy(host, start, len);
+    host[len] = '\0';
 
-    doc["tag"] = authStr;
+    *port = (start[len] == ':') ? (uint16_t)atoi(&start[len + 1]) : ((https) ? 443 : 80);
+    return true;
 }
 
-static void _array2string(uint8_t array[], unsigned int len, char buffer[]) {
+void _array2string(uint8_t array[], unsigned int len, char buffer[]) {
     for (unsigned int i = 0; i < len; i++) {
         uint8_t nib1 = (array[i] >> 4) & 0x0F;
         uint8_t nib2 = (array[i] >> 0) & 0x0F;
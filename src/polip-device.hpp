@@ -23,13 +23,17 @@
 #include <ArduinoCrypto.h>
 #include <ESP8266HTTPClient.h>
 
+#include "./polip-compress.hpp"
 #include "./polip-core.hpp"
+#include "./polip-dns.hpp"
+#include "./polip-stats.hpp"
 
 //==============================================================================
 //  Preprocessor Constants
 //==============================================================================
 
-//! Fixed device ingest server URL
+//! Default device ingest server URL, "https://" needs a linked polip_tls_t
+//! Devices with a linked polip_server_list_t use its active server instead
 #ifndef POLIP_DEVICE_INGEST_SERVER_URL
 #define POLIP_DEVICE_INGEST_SERVER_URL              "http://api.okospolip.com:3021"
 #endif
@@ -51,6 +55,51 @@
 #define POLIP_MIN_ARBITRARY_MSG_BUFFER_SIZE         (512)
 #endif
 
+//! JSON doc size used to get value while resynchronizing a failed request
+#ifndef POLIP_VALUE_DOC_SIZE
+#define POLIP_VALUE_DOC_SIZE                        (256)
+#endif
+
+//! Max outstanding values requested from server, 1 keeps strict sequencing (<= 32)
+#ifndef POLIP_MAX_VALUE_WINDOW
+#define POLIP_MAX_VALUE_WINDOW                      (8)
+#endif
+
+//! Values persisted ahead of use in windowed mode, bounded by negotiated window
+#ifndef POLIP_VALUE_PERSIST_AHEAD
+#define POLIP_VALUE_PERSIST_AHEAD                   (4)
+#endif
+
+//! Consecutive not-modified replies (untagged) accepted before a full poll is forced
+#ifndef POLIP_MAX_NOT_MODIFIED
+#define POLIP_MAX_NOT_MODIFIED                      (8)
+#endif
+
+//! Max bytes of each request / response copied to debug sink
+#ifndef POLIP_DEBUG_CAPTURE_LEN
+#define POLIP_DEBUG_CAPTURE_LEN                     (128)
+#endif
+
+//! Response timeout for linked connections, bounds a stalled server's cost
+#ifndef POLIP_CONNECTION_DEFAULT_TIMEOUT_MS
+#define POLIP_CONNECTION_DEFAULT_TIMEOUT_MS         (2000)
+#endif
+
+//! Enables per-phase request latency instrumentation, compiled out otherwise
+#ifndef POLIP_LATENCY_STATS
+#define POLIP_LATENCY_STATS                         (false)
+#endif
+
+//! Clock used for latency instrumentation, can be swapped for a cycle counter
+#ifndef POLIP_LATENCY_CLOCK
+#define POLIP_LATENCY_CLOCK()                       micros()
+#endif
+
+//! Upper bounds of request latency histogram buckets in clock ticks (POLIP_STATS_HIST_BUCKETS - 1)
+#ifndef POLIP_LATENCY_HIST_BOUNDS
+#define POLIP_LATENCY_HIST_BOUNDS                   {10000UL, 20000UL, 50000UL, 100000UL, 200000UL, 500000UL, 1000000UL}
+#endif
+
 //! Buffer size needed to construct URI's with parameters
 #ifndef POLIP_QUERY_URI_BUFFER_SIZE
 #define POLIP_QUERY_URI_BUFFER_SIZE                 (128)
@@ -81,10 +130,105 @@
     )                                                                           \
 )
 
+//==============================================================================
+//  Enumerated Constants
+//==============================================================================
+
+/**
+ * Server end-points, used to key per end-point instrumentation
+ */
+typedef enum _polip_endpoint {
+    POLIP_ENDPOINT_POLL,
+    POLIP_ENDPOINT_META,
+    POLIP_ENDPOINT_STATE,
+    POLIP_ENDPOINT_ERROR,
+    POLIP_ENDPOINT_SENSE,
+    POLIP_ENDPOINT_EXCHANGE,
+    POLIP_ENDPOINT_VALUE,
+    POLIP_ENDPOINT_RPC,
+    POLIP_ENDPOINT_SCHEMA,
+    POLIP_ENDPOINT_ERROR_SEMANTIC,
+    _POLIP_ENDPOINT_COUNT
+} polip_endpoint_t;
+
+/**
+ * Wire encoding of request / response bodies, tag is computed over the 
+ * encoded bytes
+ */
+typedef enum _polip_encoding {
+    POLIP_ENCODING_JSON,                //! Text JSON, always supported
+    POLIP_ENCODING_MSGPACK              //! MessagePack, opt-in per device
+} polip_encoding_t;
+
+/**
+ * Phases of a request timed by latency instrumentation
+ * HTTP client does not expose connect / send / first byte separately, so 
+ * these are measured together as exchange.
+ */
+typedef enum _polip_latency_phase {
+    POLIP_LATENCY_PHASE_PACK,           //! Packing request fields (excluding tag)
+    POLIP_LATENCY_PHASE_TAG,            //! Computing request tag
+    POLIP_LATENCY_PHASE_SERIALIZE,      //! Serializing request into buffer
+    POLIP_LATENCY_PHASE_EXCHANGE,       //! Connect, send, await response headers
+    POLIP_LATENCY_PHASE_RECEIVE,        //! Reading response body, inflating if compressed
+    POLIP_LATENCY_PHASE_DESERIALIZE,    //! Parsing response body
+    POLIP_LATENCY_PHASE_VERIFY,         //! Checking response status and tag
+    _POLIP_LATENCY_PHASE_COUNT
+} polip_latency_phase_t;
+
 //==============================================================================
 //  Public Data Structure Declaration
 //==============================================================================
 
+/**
+ * Latency aggregate for a single end-point
+ */
+typedef struct _polip_latency_endpoint {
+    polip_stat_t phases[_POLIP_LATENCY_PHASE_COUNT]; //! Per phase min / mean / max
+    polip_stat_t total;                 //! Whole request min / mean / max
+    polip_histogram_t histogram;        //! Whole request, see POLIP_LATENCY_HIST_BOUNDS
+} polip_latency_endpoint_t;
+
+/**
+ * Latency instrumentation storage, linked to device by application
+ */
+typedef struct _polip_latency_stats {
+    polip_latency_endpoint_t endpoints[_POLIP_ENDPOINT_COUNT];
+    uint32_t _sample[_POLIP_LATENCY_PHASE_COUNT]; //! Phases of request in progress
+} polip_latency_stats_t;
+
+/**
+ * Reusable HTTP connection, linked to one or more devices by application so
+ * the socket is kept alive between requests instead of reconnecting each time
+ */
+typedef struct _polip_connection {
+    polip_dns_client_t client;          //! Underlying socket, resolves through device DNS cache
+    HTTPClient http;                    //! HTTP session bound to socket
+    uint16_t timeout_ms = POLIP_CONNECTION_DEFAULT_TIMEOUT_MS; //! Connect / response timeout
+    uint32_t requests = 0;              //! Requests sent over this connection
+} polip_connection_t;
+
+/**
+ * Alternate transport, linked to device by application to carry requests over
+ * something other than HTTP. Envelope, tag, and value handling are unchanged.
+ */
+typedef struct _polip_transport {
+    /**
+     * Sends request body and blocks for reply
+     * @param context transport specific state
+     * @param dev device making request
+     * @param path endpoint path, e.g. "/api/device/v1/state"
+     * @param body serialized request (not null terminated)
+     * @param len length of body
+     * @param response output, reply body owned by transport until next exchange
+     * @param responseLen output, length of reply
+     * @return int HTTP equivalent status (200, 304, ...), negative if no reply
+     */
+    int (*exchange)(void* context, struct _polip_device* dev, const char* path, 
+        const uint8_t* body, size_t len, const char** response, size_t* responseLen) = NULL;
+    void* context = NULL;               //! Passed back to exchange
+} polip_transport_t;
+
 /**
  * Defines all necessary meta-data to establish communication with server
  * Application code must setup all strings / parameters according to spec 
@@ -92,16 +236,43 @@
  */
 typedef struct _polip_device {  
     uint32_t value = 0;             //! Incremented value for next transmission id
+    uint8_t valueWindow = 1;        //! Outstanding values allowed, negotiated on get value
+    uint32_t _valueBase = 0;        //! Oldest value still in flight when windowed
+    uint32_t _valueInFlight = 0;    //! Bitmask of values in flight, bit 0 is base
+    uint32_t _valuePersisted = 0;   //! Value stored for next boot, at or ahead of value
+    bool _busy = false;             //! Request in flight, rejects re-entrant requests
+    bool (*loadValueCb)(struct _polip_device* dev, uint32_t* value, uint8_t* window) = NULL; //! Optional, restore persisted value
+    bool (*saveValueCb)(struct _polip_device* dev, uint32_t value, uint8_t window) = NULL;   //! Optional, persist value
+    uint32_t stateVersion = 0;      //! Version of last polled state, 0 if unknown
+    uint8_t maxNotModified = POLIP_MAX_NOT_MODIFIED; //! Untagged 304s accepted in a row, then version withheld
+    uint8_t _notModified = 0;       //! Consecutive 304s since last full (tagged) poll
     bool skipTagCheck = false;      //! Set true if key -> tag gen not needed
+    polip_encoding_t encoding = POLIP_ENCODING_JSON; //! Body encoding, reverts to JSON if server replies JSON
+    bool resyncValue = true;        //! On value mismatch, get value and replay request once
+    uint32_t valueResyncs = 0;      //! Count of in-request value resyncs
     const char* serialStr = NULL;   //! Serial identifier unique to this device
-    const uint8_t* keyStr = NULL;   //! Revocable key used for tag gen
+    const uint8_t* keyStr = NULL;   //! Revocable key used for tag gen, rotated in place needs polip_tag_invalidate
     int keyStrLen = 0;              //! Length of key buffer
     const char* hardwareStr = NULL; //! Hardware version to report to server
     const char* firmwareStr = NULL; //! Firmware version to report to server
-    bool debugMode = true;          //! Enables additional logging to Serial
+    bool debugMode = true;          //! Enables trace events and payload capture for this device
+    Print* debugSink = NULL;        //! Optional sink for raw TX / RX payload capture
+    uint16_t debugCaptureLen = POLIP_DEBUG_CAPTURE_LEN; //! Bytes captured per payload
+    
+    struct _polip_latency_stats* latencyStats = NULL; //! Optional, needs POLIP_LATENCY_STATS
+    struct _polip_connection* connection = NULL;      //! Optional, keep-alive connection (may be shared)
+    struct _polip_transport* transport = NULL;        //! Optional, replaces HTTP when linked
+    struct _polip_tls* tls = NULL;                    //! Optional, HTTPS socket and session cache
+    struct _polip_server_list* servers = NULL;        //! Optional, runtime server URLs with failover
+    struct _polip_dns_cache* dnsCache = NULL;         //! Optional, server address cached for its TTL
+    struct _polip_tag_context* tagContext = NULL;     //! Optional, cached keyed HMAC state
+    struct _polip_schema_dict* schemaDict = NULL;     //! Optional, sends state / sense positionally
     
     char* buffer = NULL;         //! Internal transmission buffer, must be linked
     uint16_t bufferLen = 0;         //! Length of transmission buffer
+    char* zBuffer = NULL;           //! Optional gzip scratch, enables body compression
+    uint16_t zBufferLen = 0;        //! Length of gzip scratch, bounds decompressed responses
+    uint16_t compressThreshold = POLIP_COMPRESS_DEFAULT_THRESHOLD; //! Smaller requests sent as is
 } polip_device_t;
 
 //==============================================================================
@@ -111,19 +282,26 @@ typedef struct _polip_device {
 /**
  * @brief Checks server health check end-point
  * 
+ * @param tls optional HTTPS context, an https server is checked without 
+ *      validation if NULL since the check carries no device data
  * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success
  */
-polip_ret_code_t polip_checkServerStatus();
+polip_ret_code_t polip_checkServerStatus(struct _polip_tls* tls = NULL);
 /**
  * @brief Gets the current state of the device from the server
+ * If a state version was returned by a previous poll, it is sent along so that
+ * the server can reply not-modified instead of the full document. A 304 is not
+ * tagged, so after maxNotModified in a row the version is withheld to force a
+ * full, verified poll.
  * 
  * @param dev pointer to device 
- * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param doc reference to JSON buffer (will clear/replace contents, empty if not modified)
  * @param timestamp pointer to formated timestamp string
  * @param queryState boolean (default true) additionally queries for state data
  * @param queryManufacturer boolean (default false) additionally queries for manufacturer defined data
  * @param queryRPC boolean (default false) additionally queries for pending rpcs
- * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success 
+ * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success;
+ *      OK_NOT_MODIFIED if state is unchanged since last poll
  */
 polip_ret_code_t polip_getState(polip_device_t* dev, JsonDocument& doc, const char* timestamp, 
         bool queryState = true, bool queryManufacturer = false, bool queryRPC = false);
@@ -169,6 +347,22 @@ polip_ret_code_t polip_pushError(polip_device_t* dev, JsonDocument& doc, const c
  * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success
  */
 polip_ret_code_t polip_pushSensors(polip_device_t* dev, JsonDocument& doc, const char* timestamp);
+/**
+ * @brief Pushes state and/or sensors and polls the server in a single request
+ * Response is a single poll-shaped document (state, manufacturer, rpc fields)
+ * that is valid for every section sent.
+ * 
+ * @param dev pointer to device 
+ * @param doc reference to JSON buffer (will clear/replace contents) - may initially contain state and/or sense fields
+ * @param timestamp pointer to formated timestamp string
+ * @param poll boolean additionally polls server, query flags ignored if false
+ * @param queryState boolean (default true) queries for state data while polling
+ * @param queryManufacturer boolean (default false) queries for manufacturer defined data while polling
+ * @param queryRPC boolean (default false) queries for pending rpcs while polling
+ * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success
+ */
+polip_ret_code_t polip_exchange(polip_device_t* dev, JsonDocument& doc, const char* timestamp, bool poll,
+        bool queryState = true, bool queryManufacturer = false, bool queryRPC = false);
 /**
  * @brief Gets message identifier value from server (used internally for synchronization)
  * 
@@ -179,6 +373,50 @@ polip_ret_code_t polip_pushSensors(polip_device_t* dev, JsonDocument& doc, const
  * @return polip_ret_code_t error enum any non-recoverable error condition with server; OK on success
  */
 polip_ret_code_t polip_getValue(polip_device_t* dev, JsonDocument& doc, const char* timestamp);
+/**
+ * @brief Restores message identifier value persisted by a previous boot
+ * Avoids the value mismatch and resync on the first request after boot. In
+ * strict mode the exact next value is stored after every acknowledged request;
+ * in windowed mode it runs ahead of use within the window, so storage is
+ * written once per block.
+ * 
+ * @param dev pointer to device (loadValueCb must be linked)
+ * @return polip_ret_code_t MISSING_HOOK if no load hook; WORKFLOW if nothing stored; OK on success
+ */
+polip_ret_code_t polip_restoreValue(polip_device_t* dev);
+/**
+ * @brief Reserves the next message identifier value for a request
+ * In strict mode (window of 1) the value is only advanced on release. In 
+ * windowed mode several values may be reserved before any is released, 
+ * allowing requests to be in flight at the same time.
+ * 
+ * @param dev pointer to device
+ * @param value pointer to store reserved value
+ * @return polip_ret_code_t VALUE_WINDOW_FULL if window is exhausted; OK on success
+ */
+polip_ret_code_t polip_reserveValue(polip_device_t* dev, uint32_t* value);
+/**
+ * @brief Releases a value reserved for a request once its response is handled
+ * 
+ * @param dev pointer to device
+ * @param value previously reserved value
+ * @param acknowledged boolean true if server accepted the request
+ */
+void polip_releaseValue(polip_device_t* dev, uint32_t value, bool acknowledged);
+/**
+ * @brief Gets latency aggregate for an end-point
+ * 
+ * @param dev pointer to device
+ * @param endpoint end-point to query
+ * @return const polip_latency_endpoint_t* pointer to aggregate; NULL if stats not linked
+ */
+const polip_latency_endpoint_t* polip_getLatencyStats(polip_device_t* dev, polip_endpoint_t endpoint);
+/**
+ * @brief Clears all latency aggregates of device
+ * 
+ * @param dev pointer to device
+ */
+void polip_resetLatencyStats(polip_device_t* dev);
 /**
  * @brief Pushes RPC response to the server
  * 
@@ -0,0 +1,338 @@
+/**
+ * @file polip-dns.cpp
+ * @author Curt Henrichs
+ * @brief Polip DNS
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib resolver cache, minimal A-record queries over UDP.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <strings.h>
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "./polip-dns.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define DNS_PORT                                    (53)
+#define DNS_HEADER_LEN                              (12)
+#define DNS_PACKET_SIZE                             (512) // Largest reply without EDNS
+#define DNS_FLAG_RESPONSE                           (0x80)
+#define DNS_FLAG_RECURSION_DESIRED                  (0x01)
+#define DNS_RCODE_MASK                              (0x0F)
+#define DNS_TYPE_A                                  (1)
+#define DNS_CLASS_IN                                (1)
+#define DNS_NAME_POINTER                            (0xC0)
+#define DNS_LABEL_MAX_LEN                           (63)
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static bool _open(polip_dns_cache_t* cache);
+static bool _sendQuery(polip_dns_cache_t* cache, polip_dns_entry_t* entry, unsigned long currentTime_ms);
+static void _receive(polip_dns_cache_t* cache, unsigned long currentTime_ms);
+static void _parseAnswer(polip_dns_cache_t* cache, const uint8_t* buf, size_t len,
+        unsigned long currentTime_ms);
+static int _skipName(const uint8_t* buf, size_t len, size_t pos);
+static polip_dns_entry_t* _findEntry(polip_dns_cache_t* cache, const char* host);
+static polip_dns_entry_t* _claimEntry(polip_dns_cache_t* cache, const char* host,
+        unsigned long currentTime_ms);
+static bool _fresh(const polip_dns_entry_t* entry, unsigned long currentTime_ms);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+bool polip_dns_resolve(polip_dns_cache_t* cache, const char* host, IPAddress* address,
+        unsigned long currentTime_ms) {
+    if (address->fromString(host)) {
+        return true;
+    } else if (host[0] == '\0' || strlen(host) >= POLIP_DNS_HOST_BUFFER_SIZE || !_open(cache)) {
+        return false;
+    }
+
+    _receive(cache, currentTime_ms);
+
+    polip_dns_entry_t* entry = _findEntry(cache, host);
+    if (entry == NULL) {
+        entry = _claimEntry(cache, host, currentTime_ms);
+    }
+
+    if (_fresh(entry, currentTime_ms)) {
+        // Refresh ahead of expiry so later requests never wait on DNS
+        unsigned long age = currentTime_ms - entry->resolvedTimer;
+        bool due = age >= (uint64_t)entry->ttl_ms * cache->params.refreshPercent / 100;
+        if (due && (!entry->querying || (currentTime_ms - entry->queryTimer) >= cache->params.retryThreshold)) {
+            _sendQuery(cache, entry, currentTime_ms);
+        }
+
+        cache->state.hits++;
+        *address = entry->address;
+        return true;
+    }
+
+    bool due = !entry->querying || (currentTime_ms - entry->queryTimer) >= cache->params.retryThreshold;
+
+    if (entry->valid) {
+        // Expired, last address likely still right; refresh without waiting
+        //  so an unreachable DNS server never stalls requests
+        if (due) {
+            _sendQuery(cache, entry, currentTime_ms);
+        }
+
+        cache->state.stale++;
+        *address = entry->address;
+        return true;
+    }
+
+    // Nothing usable, wait only on a new query, an unanswered one within retry threshold is likely lost
+    if (due && _sendQuery(cache, entry, currentTime_ms)) {
+        unsigned long start = millis();
+        while (entry->querying && (millis() - start) < cache->params.timeout) {
+            yield();
+            _receive(cache, millis());
+        }
+    }
+
+    if (!entry->valid) {
+        return false;
+    }
+
+    cache->state.misses++;
+    *address = entry->address;
+    return true;
+}
+
+void polip_dns_update(polip_dns_cache_t* cache, unsigned long currentTime_ms) {
+    if (cache->state.open) {
+        _receive(cache, currentTime_ms);
+    }
+}
+
+int _polip_dns_client::connect(const char* host, uint16_t port) {
+    IPAddress address;
+    if (cache != NULL && polip_dns_resolve(cache, host, &address, millis())) {
+        return WiFiClient::connect(address, port);
+    }
+    return WiFiClient::connect(host, port);
+}
+
+std::unique_ptr<WiFiClient> _polip_dns_client::clone() const {
+    return std::unique_ptr<WiFiClient>(new _polip_dns_client(*this));
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static bool _open(polip_dns_cache_t* cache) {
+    if (!cache->state.open) {
+        cache->state.open = cache->udp.begin(0); // Ephemeral local port
+    }
+    return cache->state.open;
+}
+
+static bool _sendQuery(polip_dns_cache_t* cache, polip_dns_entry_t* entry, unsigned long currentTime_ms) {
+    uint8_t packet[DNS_HEADER_LEN + POLIP_DNS_HOST_BUFFER_SIZE + 1 + 4];
+    size_t pos = DNS_HEADER_LEN;
+
+    // Random ID, reply must match it to be accepted
+    uint16_t id = (uint16_t)random(0x10000);
+    memset(packet, 0, DNS_HEADER_LEN);
+    packet[0] = id >> 8;
+    packet[1] = id & 0xFF;
+    packet[2] = DNS_FLAG_RECURSION_DESIRED;
+    packet[5] = 1; // One question
+
+    // Name as length-prefixed labels
+    const char* label = entry->host;
+    while (*label != '\0') {
+        const char* dot = strchr(label, '.');
+        size_t labelLen = (dot != NULL) ? (size_t)(dot - label) : strlen(label);
+        if (labelLen == 0 || labelLen > DNS_LABEL_MAX_LEN) {
+            return false;
+        }
+
+        packet[pos++] = labelLen;
+        memcpy(&packet[pos], label, labelLen);
+        pos += labelLen;
+        label += labelLen + ((dot != NULL) ? 1 : 0);
+    }
+    packet[pos++] = 0;
+
+    packet[pos++] = 0;
+    packet[pos++] = DNS_TYPE_A;
+    packet[pos++] = 0;
+    packet[pos++] = DNS_CLASS_IN;
+
+    if (!cache->udp.beginPacket(WiFi.dnsIP(), DNS_PORT)) {
+        return false;
+    }
+    cache->udp.write(packet, pos);
+    if (!cache->udp.endPacket()) {
+        return false;
+    }
+
+    entry->querying = true;
+    entry->queryId = id;
+    entry->queryTimer = currentTime_ms;
+    return true;
+}
+
+static void _receive(polip_dns_cache_t* cache, unsigned long currentTime_ms) {
+    uint8_t buf[DNS_PACKET_SIZE];
+
+    while (cache->udp.parsePacket() > 0) {
+        // Only the configured server may answer
+        if ((uint32_t)cache->udp.remoteIP() != (uint32_t)WiFi.dnsIP() || cache->udp.remotePort() != DNS_PORT) {
+            continue;
+        }
+
+        int len = cache->udp.read(buf, sizeof(buf));
+        if (len >= DNS_HEADER_LEN) {
+            _parseAnswer(cache, buf, len, currentTime_ms);
+        }
+    }
+}
+
+static void _parseAnswer(polip_dns_cache_t* cache, const uint8_t* buf, size_t len,
+        unsigned long currentTime_ms) {
+    if (!(buf[2] & DNS_FLAG_RESPONSE)) {
+        return;
+    }
+
+    uint16_t id = (buf[0] << 8) | buf[1];
+    polip_dns_entry_t* entry = NULL;
+    for (uint8_t i = 0; i < POLIP_DNS_CACHE_SIZE; i++) {
+        if (cache->entries[i].querying && cache->entries[i].queryId == id) {
+            entry = &cache->entries[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        return; // Late reply to a retried query, or spoofed
+    }
+
+    // Answered either way, failure keeps last address
+    entry->querying = false;
+    if ((buf[3] & DNS_RCODE_MASK) != 0) {
+        return;
+    }
+
+    uint16_t questions = (buf[4] << 8) | buf[5];
+    uint16_t answers = (buf[6] << 8) | buf[7];
+    int pos = DNS_HEADER_LEN;
+
+    for (uint16_t i = 0; i < questions && pos >= 0; i++) {
+        pos = _skipName(buf, len, pos);
+        pos = (pos >= 0) ? pos + 4 : pos;
+    }
+
+    // TTL of chain is its shortest record, CNAMEs included
+    bool found = false;
+    uint32_t ttl = UINT32_MAX;
+    uint8_t address[4];
+    for (uint16_t i = 0; i < answers && pos >= 0; i++) {
+        pos = _skipName(buf, len, pos);
+        if (pos < 0 || (size_t)pos + 10 > len) {
+            return;
+        }
+
+        const uint8_t* record = &buf[pos];
+        uint16_t type = (record[0] << 8) | record[1];
+        uint16_t cls = (record[2] << 8) | record[3];
+        uint32_t recordTtl = ((uint32_t)record[4] << 24) | ((uint32_t)record[5] << 16)
+            | ((uint32_t)record[6] << 8) | record[7];
+        uint16_t dataLen = (record[8] << 8) | record[9];
+
+        pos += 10;
+        if ((size_t)pos + dataLen > len) {
+            return;
+        }
+
+        if (cls == DNS_CLASS_IN && recordTtl < ttl) {
+            ttl = recordTtl;
+        }
+        if (!found && type == DNS_TYPE_A && cls == DNS_CLASS_IN && dataLen == 4) {
+            memcpy(address, &buf[pos], 4);
+            found = true;
+        }
+        pos += dataLen;
+    }
+
+    if (!found) {
+        return;
+    }
+
+    uint32_t ttl_ms = (ttl > UINT32_MAX / 1000) ? UINT32_MAX : ttl * 1000;
+    if (ttl_ms < cache->params.minTtl_ms) {
+        ttl_ms = cache->params.minTtl_ms;
+    } else if (ttl_ms > cache->params.maxTtl_ms) {
+        ttl_ms = cache->params.maxTtl_ms;
+    }
+
+    entry->address = IPAddress(address[0], address[1], address[2], address[3]);
+    entry->ttl_ms = ttl_ms;
+    entry->resolvedTimer = currentTime_ms;
+    entry->valid = true;
+    cache->state.refreshes++;
+}
+
+static int _skipName(const uint8_t* buf, size_t len, size_t pos) {
+    while (pos < len) {
+        uint8_t labelLen = buf[pos];
+        if ((labelLen & DNS_NAME_POINTER) == DNS_NAME_POINTER) {
+            return (pos + 2 <= len) ? (int)(pos + 2) : -1; // Compressed, rest is elsewhere
+        } else if (labelLen == 0) {
+            return pos + 1;
+        }
+        pos += labelLen + 1;
+    }
+    return -1;
+}
+
+static polip_dns_entry_t* _findEntry(polip_dns_cache_t* cache, const char* host) {
+    for (uint8_t i = 0; i < POLIP_DNS_CACHE_SIZE; i++) {
+        if (strcasecmp(cache->entries[i].host, host) == 0) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static polip_dns_entry_t* _claimEntry(polip_dns_cache_t* cache, const char* host,
+        unsigned long currentTime_ms) {
+    polip_dns_entry_t* entry = &cache->entries[0];
+
+    // Empty first, then least recently resolved
+    for (uint8_t i = 0; i < POLIP_DNS_CACHE_SIZE; i++) {
+        polip_dns_entry_t* candidate = &cache->entries[i];
+        if (candidate->host[0] == '\0') {
+            entry = candidate;
+            break;
+        } else if (!candidate->valid || (entry->valid && (currentTime_ms - candidate->resolvedTimer)
+                > (currentTime_ms - entry->resolvedTimer))) {
+            entry = candidate;
+        }
+    }
+
+    strcpy(entry->host, host);
+    entry->valid = false;
+    entry->querying = false;
+    return entry;
+}
+
+static bool _fresh(const polip_dns_entry_t* entry, unsigned long currentTime_ms) {
+    return entry->valid && (currentTime_ms - entry->resolvedTimer) < entry->ttl_ms;
+}
\ No newline at end of file
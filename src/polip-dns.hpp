@@ -0,0 +1,173 @@
+/**
+ * @file polip-dns.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional resolver cache for the server host. Addresses are kept for the TTL
+ * the DNS server gave (clamped to params) and refreshed with a non-blocking
+ * query once most of the TTL has passed, so steady-state requests never wait
+ * on DNS. If the record expires anyway (DNS unreachable, or no requests for
+ * a while), the last known address is used at once while a query refreshes
+ * it in the background. Queries go straight to the network's DNS server over
+ * UDP, since the system resolver does not expose TTLs.
+ * 
+ * Applies to plain HTTP requests through polip_dns_client_t. HTTPS sockets
+ * resolve inside BearSSL and rely on keep-alive / session resumption instead.
+ */
+
+#ifndef POLIP_DNS_HPP
+#define POLIP_DNS_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <memory>
+#include <WiFiClient.h>
+#include <WiFiUdp.h>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Hosts cached, least recently resolved is replaced
+#ifndef POLIP_DNS_CACHE_SIZE
+#define POLIP_DNS_CACHE_SIZE                        (2)
+#endif
+
+//! Longest host name cached, longer names bypass cache
+#ifndef POLIP_DNS_HOST_BUFFER_SIZE
+#define POLIP_DNS_HOST_BUFFER_SIZE                  (64)
+#endif
+
+//! Shortest TTL honoured, stops a zero TTL from querying every request
+#ifndef POLIP_DNS_DEFAULT_MIN_TTL
+#define POLIP_DNS_DEFAULT_MIN_TTL                   (30000UL)
+#endif
+
+//! Longest TTL honoured
+#ifndef POLIP_DNS_DEFAULT_MAX_TTL
+#define POLIP_DNS_DEFAULT_MAX_TTL                   (3600000UL)
+#endif
+
+//! Percent of TTL after which a background refresh is sent
+#ifndef POLIP_DNS_DEFAULT_REFRESH_PERCENT
+#define POLIP_DNS_DEFAULT_REFRESH_PERCENT           (75)
+#endif
+
+//! Wait for answer when nothing usable is cached
+#ifndef POLIP_DNS_DEFAULT_TIMEOUT
+#define POLIP_DNS_DEFAULT_TIMEOUT                   (2000L)
+#endif
+
+//! Wait before an unanswered query is sent again
+#ifndef POLIP_DNS_DEFAULT_RETRY_THRESHOLD
+#define POLIP_DNS_DEFAULT_RETRY_THRESHOLD           (5000L)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Cached address of one host
+ */
+typedef struct _polip_dns_entry {
+    char host[POLIP_DNS_HOST_BUFFER_SIZE] = "";
+    IPAddress address;
+    bool valid = false;                 //! Address known, possibly expired
+    uint32_t ttl_ms = 0;                //! Clamped TTL of address
+    unsigned long resolvedTimer = 0;    //! Address received (ms)
+    bool querying = false;              //! Query sent, awaiting answer
+    uint16_t queryId = 0;
+    unsigned long queryTimer = 0;       //! Query sent (ms)
+} polip_dns_entry_t;
+
+/**
+ * Resolver cache, linked to one or more devices by application
+ */
+typedef struct _polip_dns_cache {
+
+    /**
+     * Dedicated socket for queries
+     */
+    WiFiUDP udp;
+
+    /**
+     * Cached hosts
+     */
+    struct _polip_dns_entry entries[POLIP_DNS_CACHE_SIZE];
+
+    /**
+     * Inner table for parameters used by cache
+     * Defaults set as defined in struct
+     */
+    struct _polip_dns_cache_params {
+        uint32_t minTtl_ms = POLIP_DNS_DEFAULT_MIN_TTL;
+        uint32_t maxTtl_ms = POLIP_DNS_DEFAULT_MAX_TTL;
+        uint8_t refreshPercent = POLIP_DNS_DEFAULT_REFRESH_PERCENT;
+        unsigned long timeout = POLIP_DNS_DEFAULT_TIMEOUT;
+        unsigned long retryThreshold = POLIP_DNS_DEFAULT_RETRY_THRESHOLD;
+    } params;
+
+    /**
+     * Inner table for state used by cache
+     */
+    struct _polip_dns_cache_state {
+        bool open = false;              //! Socket bound
+        uint32_t hits = 0;              //! Resolved from cache within TTL
+        uint32_t misses = 0;            //! Waited on DNS
+        uint32_t refreshes = 0;         //! Answers received
+        uint32_t stale = 0;             //! Expired address used while refreshing
+    } state;
+
+} polip_dns_cache_t;
+
+/**
+ * Plain socket resolving host names through a linked cache. Falls back to
+ * system resolver if cache is not linked or host cannot be resolved.
+ */
+typedef class _polip_dns_client : public WiFiClient {
+public:
+    struct _polip_dns_cache* cache = NULL;
+
+    using WiFiClient::connect;
+    int connect(const char* host, uint16_t port) override;
+    std::unique_ptr<WiFiClient> clone() const override;  // HTTPClient keeps a copy
+} polip_dns_client_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Resolves host from cache, sending background refresh when near or past
+ * expiry. Blocks on DNS only if host has no address yet.
+ * 
+ * @param cache pointer to cache
+ * @param host host name (dotted IPs are parsed without lookup)
+ * @param address output address
+ * @param currentTime_ms time generated from millis()
+ * @return bool true if address resolved, fresh or stale
+ */
+bool polip_dns_resolve(polip_dns_cache_t* cache, const char* host, IPAddress* address,
+        unsigned long currentTime_ms);
+/**
+ * @brief Receives answers to background refreshes. Optional, resolve also
+ * does this, but calling from loop keeps refresh from waiting on next request.
+ * 
+ * @param cache pointer to cache
+ * @param currentTime_ms time generated from millis()
+ */
+void polip_dns_update(polip_dns_cache_t* cache, unsigned long currentTime_ms);
+
+//==============================================================================
+
+#endif //POLIP_DNS_HPP
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file polip-gateway.cpp
+ * @author Curt Henrichs
+ * @brief Polip Gateway
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib gateway mode, many logical devices multiplexed over a shared
+ * connection pool and scratch arena.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include "./polip-gateway.hpp"
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static bool _inBackoff(polip_gateway_slot_t* slot, unsigned long currentTime_ms);
+static void _updateBackoff(polip_gateway_slot_t* slot, polip_workflow_t* wkObj, 
+        polip_ret_code_t wkStatus, unsigned long currentTime_ms);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_gateway_initialize(polip_gateway_t* gwObj, unsigned long currentTime_ms) {
+    if (gwObj->workflows == NULL || gwObj->workflowCount == 0 || gwObj->arena == NULL) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    gwObj->state.cursor = 0;
+    gwObj->state.rounds = 0;
+    gwObj->state.skipped = 0;
+
+    polip_ret_code_t status = POLIP_OK;
+    for (uint16_t i = 0; i < gwObj->workflowCount; i++) {
+        polip_workflow_t* wkObj = &gwObj->workflows[i];
+        if (wkObj->device == NULL) {
+            return POLIP_ERROR_LIB_REQUEST;
+        }
+
+        // Devices run one at a time so a single arena serves all of them
+        wkObj->device->buffer = gwObj->arena;
+        wkObj->device->bufferLen = gwObj->arenaLen;
+
+        if (gwObj->connections != NULL && gwObj->connectionCount > 0) {
+            wkObj->device->connection = &gwObj->connections[i % gwObj->connectionCount];
+        }
+
+        if (gwObj->params.oneEventPerTurn) {
+            wkObj->params.maxEventsPerUpdate = 1; // Remaining events wait for next turn
+        }
+
+        if (gwObj->slots != NULL) {
+            gwObj->slots[i] = polip_gateway_slot_t();
+        }
+
+        polip_ret_code_t wkStatus = polip_workflow_initialize(wkObj, currentTime_ms);
+        if (status == POLIP_OK) {
+            status = wkStatus;
+        }
+    }
+
+    return status;
+}
+
+polip_ret_code_t polip_gateway_teardown(polip_gateway_t* gwObj) {
+    polip_ret_code_t status = POLIP_OK;
+    for (uint16_t i = 0; i < gwObj->workflowCount; i++) {
+        polip_ret_code_t wkStatus = polip_workflow_teardown(&gwObj->workflows[i]);
+        if (status == POLIP_OK) {
+            status = wkStatus;
+        }
+    }
+
+    for (uint8_t i = 0; i < gwObj->connectionCount; i++) {
+        gwObj->connections[i].client.stop();
+    }
+
+    return status;
+}
+
+polip_ret_code_t polip_gateway_periodic_update(polip_gateway_t* gwObj, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms) {
+    polip_ret_code_t status = POLIP_OK;
+
+    uint16_t count = gwObj->params.devicesPerUpdate;
+    if (count > gwObj->workflowCount) {
+        count = gwObj->workflowCount;
+    }
+
+    // Bounded by one pass so a fleet fully in backoff returns immediately
+    uint16_t serviced = 0;
+    for (uint16_t n = 0; n < gwObj->workflowCount && serviced < count; n++) {
+        polip_workflow_t* wkObj = &gwObj->workflows[gwObj->state.cursor];
+        polip_gateway_slot_t* slot = (gwObj->slots != NULL) ? &gwObj->slots[gwObj->state.cursor] : NULL;
+
+        if (_inBackoff(slot, currentTime_ms)) {
+            gwObj->state.skipped++;
+        } else {
+            // Errors stay with the device (flags / hook), others still get a turn
+            polip_ret_code_t wkStatus = polip_workflow_periodic_update(wkObj, doc, timestamp, currentTime_ms);
+            if (status == POLIP_OK) {
+                status = wkStatus;
+            }
+
+            _updateBackoff(slot, wkObj, wkStatus, currentTime_ms);
+            serviced++;
+        }
+
+        gwObj->state.cursor++;
+        if (gwObj->state.cursor >= gwObj->workflowCount) {
+            gwObj->state.cursor = 0;
+            gwObj->state.rounds++;
+        }
+    }
+
+    return status;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static bool _inBackoff(polip_gateway_slot_t* slot, unsigned long currentTime_ms) {
+    return slot != NULL && slot->backoff_ms != 0 
+        && (long)(currentTime_ms - slot->retryTime) < 0;
+}
+
+static void _updateBackoff(polip_gateway_slot_t* slot, polip_workflow_t* wkObj, 
+        polip_ret_code_t wkStatus, unsigned long currentTime_ms) {
+    if (slot == NULL) {
+        return;
+    }
+
+    if (wkObj->state.lastError == POLIP_ERROR_SERVER_ERROR) {
+        // Unreachable or failing server, back off exponentially
+        slot->failures++;
+        if (slot->backoff_ms == 0) {
+            slot->backoff_ms = POLIP_GATEWAY_BACKOFF_MIN_MS;
+        } else if (slot->backoff_ms < POLIP_GATEWAY_BACKOFF_MAX_MS) {
+            slot->backoff_ms *= 2;
+            if (slot->backoff_ms > POLIP_GATEWAY_BACKOFF_MAX_MS) {
+                slot->backoff_ms = POLIP_GATEWAY_BACKOFF_MAX_MS;
+            }
+        }
+        slot->retryTime = currentTime_ms + slot->backoff_ms;
+    } else if (wkStatus == POLIP_OK) {
+        slot->backoff_ms = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+ * @file polip-gateway.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Gateway mode hosts many logical devices, each with its own serial, key and
+ * value, on one physical board. Devices share a pool of keep-alive connections
+ * and one scratch arena, and a round-robin scheduler interleaves their
+ * workflows so no device can starve the others.
+ */
+
+#ifndef POLIP_GATEWAY_HPP
+#define POLIP_GATEWAY_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+#include "./polip-workflow.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Devices serviced per gateway update call
+#ifndef POLIP_GATEWAY_DEFAULT_DEVICES_PER_UPDATE
+#define POLIP_GATEWAY_DEFAULT_DEVICES_PER_UPDATE    (1)
+#endif
+
+//! First backoff after a device hits a server / network error
+#ifndef POLIP_GATEWAY_BACKOFF_MIN_MS
+#define POLIP_GATEWAY_BACKOFF_MIN_MS                (1000UL)
+#endif
+
+//! Backoff doubles per consecutive failure up to this limit
+#ifndef POLIP_GATEWAY_BACKOFF_MAX_MS
+#define POLIP_GATEWAY_BACKOFF_MAX_MS                (60000UL)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Per-device scheduling state, optional array parallel to workflows
+ */
+typedef struct _polip_gateway_slot {
+    unsigned long retryTime = 0;        //! Device skipped until this time (ms)
+    unsigned long backoff_ms = 0;       //! Current backoff, 0 if healthy
+    uint32_t failures = 0;              //! Total server / network failures
+} polip_gateway_slot_t;
+
+/**
+ * Gateway hosting many logical devices. All storage is owned by application
+ * and linked before initialize.
+ */
+typedef struct _polip_gateway {
+
+    /**
+     * Array of workflows, one per logical device, each linked to its device
+     * (and optionally RPC workflow). Device buffers are replaced by arena.
+     */
+    struct _polip_workflow * workflows = NULL;
+    uint16_t workflowCount = 0;
+
+    /**
+     * Optional scheduling state, one per workflow, NULL disables backoff
+     */
+    struct _polip_gateway_slot * slots = NULL;
+
+    /**
+     * Pool of keep-alive connections, devices are assigned round-robin
+     */
+    struct _polip_connection * connections = NULL;
+    uint8_t connectionCount = 0;
+
+    /**
+     * Shared transmission buffer, sized for largest request of any device
+     */
+    char* arena = NULL;
+    uint16_t arenaLen = 0;
+
+    /**
+     * Inner table for parameters used during gateway update
+     * Defaults set as defined in struct
+     */
+    struct _polip_gateway_params {
+        uint16_t devicesPerUpdate = POLIP_GATEWAY_DEFAULT_DEVICES_PER_UPDATE;
+        bool oneEventPerTurn = true;    //! Device runs at most one event per turn
+    } params;
+
+    /**
+     * Inner table for state used during gateway update
+     */
+    struct _polip_gateway_state {
+        uint16_t cursor = 0;            //! Next device to service
+        uint32_t rounds = 0;            //! Completed passes over all devices
+        uint32_t skipped = 0;           //! Turns skipped by devices in backoff
+    } state;
+
+} polip_gateway_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Links arena and connections to each device and initializes each 
+ * workflow, call during setup
+ * 
+ * @param gwObj gateway object with workflows, connections and arena linked
+ * @param currentTime_ms time used to seed internal soft timers
+ * @return polip_ret_code_t LIB_REQUEST if storage not linked; first workflow error; OK on success
+ */
+polip_ret_code_t polip_gateway_initialize(polip_gateway_t* gwObj, unsigned long currentTime_ms);
+/**
+ * @brief Tears down each workflow and closes pooled connections
+ * 
+ * @param gwObj gateway object
+ * @return polip_ret_code_t first workflow error; OK on success
+ */
+polip_ret_code_t polip_gateway_teardown(polip_gateway_t* gwObj);
+/**
+ * @brief Services the next devices in round-robin order, call in main loop
+ * Devices in backoff are passed over without spending a request, so an
+ * unreachable device costs at most one timeout per backoff period.
+ * 
+ * @param gwObj gateway object
+ * @param doc reference to JSON buffer shared by all devices (will clear/replace contents)
+ * @param timestamp pointer to formatted timestamp string
+ * @param currentTime_ms time generated from millis() for periodic update
+ * @return polip_ret_code_t first non-recoverable workflow error this call; OK on success
+ */
+polip_ret_code_t polip_gateway_periodic_update(polip_gateway_t* gwObj, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms);
+
+//==============================================================================
+
+#endif //POLIP_GATEWAY_HPP
\ No newline at end of file
@@ -0,0 +1,250 @@
+/**
+ * @file polip-longpoll.cpp
+ * @author Curt Henrichs
+ * @brief Polip Long-Poll
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib asynchronous long-poll of device state.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+#include <ESP8266WiFi.h>
+
+#include "./polip-longpoll.hpp"
+#include "./polip-device-internal.hpp"
+#include "./polip-dns.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define LONGPOLL_ENDPOINT                           "/api/device/v1/poll"
+#define LONGPOLL_HOST_BUFFER_SIZE                   (64)
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _reset(polip_longpoll_t* lp);
+static void _handleHeaderLine(polip_longpoll_t* lp);
+static unsigned long _retryThreshold(polip_longpoll_t* lp);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_longpoll_start(polip_longpoll_t* lp, polip_device_t* dev, JsonDocument& doc, 
+        const char* timestamp, unsigned long currentTime_ms, bool queryState, 
+        bool queryManufacturer, bool queryRPC) {
+    char host[LONGPOLL_HOST_BUFFER_SIZE];
+    char uri[POLIP_QUERY_URI_BUFFER_SIZE];
+    uint16_t port;
+    bool secure;
+    IPAddress address;
+
+    if (lp->buffer == NULL || dev->valueWindow < 2 || lp->state.inFlight) {
+        return POLIP_ERROR_LIB_REQUEST; // Strict sequencing cannot overlap requests
+    }
+
+    if (!_parseServerUrl(_serverUrl(dev), host, sizeof(host), &port, &secure) || secure) {
+        return POLIP_ERROR_LIB_REQUEST; // Plain socket only, timed polling stays in use
+    }
+
+    _reset(lp);
+    lp->state.retryTimer = currentTime_ms;
+
+    uint32_t value;
+    if (polip_reserveValue(dev, &value) != POLIP_OK) {
+        return POLIP_ERROR_VALUE_WINDOW_FULL;
+    }
+
+    if (lp->state.failures < UINT8_MAX) {
+        lp->state.failures++; // Cleared once a poll is answered
+    }
+
+    // Resolve and connect with short bounds, system defaults would stall workflow for seconds
+    bool resolved = (dev->dnsCache != NULL && polip_dns_resolve(dev->dnsCache, host, &address, currentTime_ms))
+        || WiFi.hostByName(host, address, lp->params.connectTimeout);
+    lp->client.setTimeout(lp->params.connectTimeout);
+    if (!resolved || !lp->client.connect(address, port)) {
+        lp->client.stop();
+        polip_releaseValue(dev, value, false);
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+
+    int len = sprintf(uri, LONGPOLL_ENDPOINT "?state=%s&manufacturer=%s&rpc=%s&wait=%u",
+        (queryState) ? "true" : "false",
+        (queryManufacturer) ? "true" : "false",
+        (queryRPC) ? "true" : "false",
+        lp->params.wait_s
+    );
+    bool versioned = _sendStateVersion(dev);
+    if (versioned) {
+        sprintf(uri + len, "&version=%lu", (unsigned long)dev->stateVersion);
+    }
+
+    // Body in device encoding, tag was computed over that serialization
+    doc.clear();
+    _packRequest(dev, doc, timestamp, value);
+    size_t bodyLen = _serializeRequest(dev, doc);
+    bool msgpack = (dev->encoding == POLIP_ENCODING_MSGPACK);
+
+    // HTTP/1.0 so response ends with content length or close, never chunked
+    lp->client.print(F("POST "));
+    lp->client.print(uri);
+    lp->client.print(F(" HTTP/1.0\r\nHost: "));
+    lp->client.print(host);
+    lp->client.print(F("\r\nContent-Type: "));
+    lp->client.print((msgpack) ? F(MIME_MSGPACK "\r\nAccept: " MIME_MSGPACK) : F(MIME_JSON));
+    lp->client.print(F("\r\nContent-Length: "));
+    lp->client.print((unsigned long)bodyLen);
+    lp->client.print(F("\r\n\r\n"));
+    lp->client.write((const uint8_t*)dev->buffer, bodyLen);
+
+    // Server checked value on arrival, free its slot so base is not pinned
+    //  while held; response is still matched against it
+    polip_releaseValue(dev, value, false);
+
+    lp->state.value = value;
+    lp->state.versioned = versioned;
+    lp->state.inFlight = true;
+    lp->state.startTimer = currentTime_ms;
+    return POLIP_OK;
+}
+
+bool polip_longpoll_due(polip_longpoll_t* lp, unsigned long currentTime_ms) {
+    return !lp->state.inFlight && (lp->state.retryTimer == 0 
+        || (currentTime_ms - lp->state.retryTimer) >= _retryThreshold(lp));
+}
+
+bool polip_longpoll_update(polip_longpoll_t* lp, polip_device_t* dev, unsigned long currentTime_ms) {
+    if (!lp->state.inFlight) {
+        return false;
+    } else if (lp->state.complete) {
+        return true;
+    }
+
+    while (lp->client.available() > 0) {
+        int c = lp->client.read();
+        if (c < 0) {
+            break;
+        }
+
+        if (!lp->state.headersDone) {
+            if (c == '\n') {
+                lp->state.line[lp->state.lineLen] = '\0';
+                _handleHeaderLine(lp);
+                lp->state.lineLen = 0;
+            } else if (c != '\r' && lp->state.lineLen < POLIP_LONGPOLL_LINE_BUFFER_SIZE - 1) {
+                lp->state.line[lp->state.lineLen++] = (char)c;
+            }
+        } else if (lp->state.rxLen < lp->bufferLen - 1) {
+            lp->buffer[lp->state.rxLen++] = (char)c;
+        } else {
+            lp->state.httpCode = 0; // Too large, fails as server error
+        }
+
+        if (lp->state.headersDone && lp->state.contentLength >= 0 
+                && lp->state.rxLen >= lp->state.contentLength) {
+            lp->state.complete = true;
+            break;
+        }
+    }
+
+    if (!lp->state.complete && !lp->client.connected() && lp->client.available() <= 0) {
+        lp->state.complete = true; // Closed by server, body ends here
+    }
+
+    if (!lp->state.complete && (currentTime_ms - lp->state.startTimer) 
+            >= (lp->params.wait_s * 1000UL + lp->params.timeoutMargin)) {
+        lp->state.httpCode = 0;
+        lp->state.complete = true;
+    }
+
+    return lp->state.complete;
+}
+
+polip_ret_code_t polip_longpoll_finish(polip_longpoll_t* lp, polip_device_t* dev, 
+        JsonDocument& doc, unsigned long currentTime_ms) {
+    if (!lp->state.inFlight || !lp->state.complete) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    lp->client.stop();
+    lp->state.inFlight = false;
+
+    if (lp->state.httpCode == 0) {
+        lp->state.cancels++; // Timed out or broken
+        lp->state.retryTimer = currentTime_ms;
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+
+    polip_ret_code_t status = _completeRequest(dev, doc, lp->state.httpCode, 
+        lp->buffer, lp->state.rxLen, lp->state.value, lp->state.versioned);
+    lp->state.completions++;
+    lp->state.failures = 0; // Server answered, failure below is not connectivity
+
+    if (status == POLIP_OK) {
+        dev->stateVersion = doc["version"];
+        dev->_notModified = 0;
+        lp->state.retryTimer = 0; // Re-arm right away
+    } else if (status == POLIP_OK_NOT_MODIFIED) {
+        lp->state.retryTimer = 0;
+    } else {
+        lp->state.retryTimer = currentTime_ms;
+    }
+
+    return status;
+}
+
+void polip_longpoll_cancel(polip_longpoll_t* lp, polip_device_t* dev) {
+    if (!lp->state.inFlight) {
+        return;
+    }
+
+    lp->client.stop();
+    lp->state.inFlight = false;
+    lp->state.retryTimer = 0;
+    lp->state.cancels++;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _reset(polip_longpoll_t* lp) {
+    lp->state.complete = false;
+    lp->state.headersDone = false;
+    lp->state.httpCode = 0;
+    lp->state.contentLength = -1;
+    lp->state.rxLen = 0;
+    lp->state.lineLen = 0;
+}
+
+static void _handleHeaderLine(polip_longpoll_t* lp) {
+    const char* line = lp->state.line;
+
+    if (lp->state.lineLen == 0) {
+        lp->state.headersDone = true;
+    } else if (strncmp(line, "HTTP/", 5) == 0) {
+        const char* code = strchr(line, ' ');
+        lp->state.httpCode = (code != NULL) ? atoi(code + 1) : 0;
+    } else if (strncasecmp(line, "Content-Length:", 15) == 0) {
+        lp->state.contentLength = atol(line + 15);
+    }
+}
+
+static unsigned long _retryThreshold(polip_longpoll_t* lp) {
+    unsigned long threshold = lp->params.retryThreshold;
+    for (uint8_t i = 1; i < lp->state.failures && threshold < lp->params.maxRetryThreshold; i++) {
+        threshold *= 2;
+    }
+    return (threshold < lp->params.maxRetryThreshold) ? threshold : lp->params.maxRetryThreshold;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+/**
+ * @file polip-longpoll.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Long-poll variant of polip_getState. The server holds the poll open until
+ * state or RPCs change (or wait expires), while the workflow keeps running 
+ * other events. The poll runs on its own socket and buffer and completes 
+ * asynchronously, overlapping other requests, so it needs a negotiated value
+ * window of at least 2. Its value leaves the window once sent, so a held poll
+ * never blocks the window from advancing.
+ */
+
+#ifndef POLIP_LONGPOLL_HPP
+#define POLIP_LONGPOLL_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <WiFiClient.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Seconds server may hold poll open
+#ifndef POLIP_LONGPOLL_DEFAULT_WAIT_S
+#define POLIP_LONGPOLL_DEFAULT_WAIT_S               (25)
+#endif
+
+//! Grace period past wait before poll is abandoned
+#ifndef POLIP_LONGPOLL_DEFAULT_TIMEOUT_MARGIN
+#define POLIP_LONGPOLL_DEFAULT_TIMEOUT_MARGIN       (5000L)
+#endif
+
+//! Wait before re-arming after a failed poll, doubled per failure in a row
+#ifndef POLIP_LONGPOLL_DEFAULT_RETRY_THRESHOLD
+#define POLIP_LONGPOLL_DEFAULT_RETRY_THRESHOLD      (5000L)
+#endif
+
+//! Longest wait before re-arming after failed polls
+#ifndef POLIP_LONGPOLL_DEFAULT_MAX_RETRY_THRESHOLD
+#define POLIP_LONGPOLL_DEFAULT_MAX_RETRY_THRESHOLD  (300000L)
+#endif
+
+//! Bound on host lookup and TCP connect, each blocks the workflow
+#ifndef POLIP_LONGPOLL_DEFAULT_CONNECT_TIMEOUT
+#define POLIP_LONGPOLL_DEFAULT_CONNECT_TIMEOUT      (1000L)
+#endif
+
+//! Longest response header line kept
+#ifndef POLIP_LONGPOLL_LINE_BUFFER_SIZE
+#define POLIP_LONGPOLL_LINE_BUFFER_SIZE             (64)
+#endif
+
+//==============================================================================
+//  Preprocessor Macros
+//==============================================================================
+
+#define POLIP_LONGPOLL_IN_FLIGHT(longPollPtr) ((longPollPtr)->state.inFlight)
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Long-poll context, linked to workflow by application
+ */
+typedef struct _polip_longpoll {
+
+    /**
+     * Dedicated socket, never shared with request connections
+     */
+    WiFiClient client;
+
+    /**
+     * Dedicated response buffer, must be linked. Request is written from
+     * device buffer as it is sent
+     */
+    char* buffer = NULL;
+    uint16_t bufferLen = 0;
+
+    /**
+     * Inner table for parameters used by long-poll
+     * Defaults set as defined in struct
+     */
+    struct _polip_longpoll_params {
+        uint16_t wait_s = POLIP_LONGPOLL_DEFAULT_WAIT_S;
+        unsigned long timeoutMargin = POLIP_LONGPOLL_DEFAULT_TIMEOUT_MARGIN;
+        unsigned long retryThreshold = POLIP_LONGPOLL_DEFAULT_RETRY_THRESHOLD;
+        unsigned long maxRetryThreshold = POLIP_LONGPOLL_DEFAULT_MAX_RETRY_THRESHOLD;
+        unsigned long connectTimeout = POLIP_LONGPOLL_DEFAULT_CONNECT_TIMEOUT;
+    } params;
+
+    /**
+     * Inner table for state used by long-poll
+     */
+    struct _polip_longpoll_state {
+        bool inFlight = false;          //! Poll sent, awaiting completion
+        bool complete = false;          //! Response fully received
+        bool headersDone = false;       //! Past HTTP response headers
+        int httpCode = 0;               //! Status of response
+        long contentLength = -1;        //! Body length, -1 until close if absent
+        uint16_t rxLen = 0;             //! Body bytes received
+        uint32_t value = 0;             //! Value held by poll
+        bool versioned = false;         //! Poll sent state version, may be answered not-modified
+        unsigned long startTimer = 0;   //! Poll sent (ms)
+        unsigned long retryTimer = 0;   //! Last failed attempt (ms), 0 re-arms right away
+        uint8_t failures = 0;           //! Attempts since a poll was last answered
+        uint32_t completions = 0;       //! Polls answered
+        uint32_t cancels = 0;           //! Polls abandoned (timeout / cancel)
+        uint16_t lineLen = 0;
+        char line[POLIP_LONGPOLL_LINE_BUFFER_SIZE];
+    } state;
+
+} polip_longpoll_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Sends long-poll on dedicated socket, returns without waiting for the
+ * response. Host lookup and connect block for at most connect timeout.
+ * 
+ * @param lp pointer to long-poll
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param timestamp pointer to formatted timestamp string
+ * @param currentTime_ms time generated from millis()
+ * @param queryState boolean additionally queries for state data
+ * @param queryManufacturer boolean additionally queries for manufacturer defined data
+ * @param queryRPC boolean additionally queries for pending rpcs
+ * @return polip_ret_code_t LIB_REQUEST if window < 2, buffer missing or
+ *      server is https; VALUE_WINDOW_FULL; SERVER_ERROR if connect failed;
+ *      OK once sent
+ */
+polip_ret_code_t polip_longpoll_start(polip_longpoll_t* lp, polip_device_t* dev, JsonDocument& doc, 
+        const char* timestamp, unsigned long currentTime_ms, bool queryState = true, 
+        bool queryManufacturer = false, bool queryRPC = false);
+/**
+ * @brief Whether poll should be (re)started. Retry wait backs off 
+ * exponentially while the server is unreachable or polls fail.
+ * 
+ * @param lp pointer to long-poll
+ * @param currentTime_ms time generated from millis()
+ * @return bool true if not in flight and retry wait has passed
+ */
+bool polip_longpoll_due(polip_longpoll_t* lp, unsigned long currentTime_ms);
+/**
+ * @brief Non-blocking receive of long-poll response. Completes as failed if
+ * poll overruns its wait.
+ * 
+ * @param lp pointer to long-poll
+ * @param dev pointer to device
+ * @param currentTime_ms time generated from millis()
+ * @return bool true once response is complete and ready to finish
+ */
+bool polip_longpoll_update(polip_longpoll_t* lp, polip_device_t* dev, unsigned long currentTime_ms);
+/**
+ * @brief Parses and verifies completed response
+ * 
+ * @param lp pointer to long-poll
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param currentTime_ms time generated from millis()
+ * @return polip_ret_code_t same codes as polip_getState; SERVER_ERROR if abandoned
+ */
+polip_ret_code_t polip_longpoll_finish(polip_longpoll_t* lp, polip_device_t* dev, 
+        JsonDocument& doc, unsigned long currentTime_ms);
+/**
+ * @brief Abandons poll in flight
+ * 
+ * @param lp pointer to long-poll
+ * @param dev pointer to device
+ */
+void polip_longpoll_cancel(polip_longpoll_t* lp, polip_device_t* dev);
+
+//==============================================================================
+
+#endif //POLIP_LONGPOLL_HPP
\ No newline at end of file
@@ -0,0 +1,198 @@
+/**
+ * @file polip-mqtt.cpp
+ * @author Curt Henrichs
+ * @brief Polip MQTT
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib MQTT request transport and RPC push.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "./polip-mqtt.hpp"
+
+#if POLIP_MQTT_ENABLED
+
+#include "./polip-device-internal.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define MQTT_PATH_ROOT                              "/api"
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static int _exchange(void* context, polip_device_t* dev, const char* path,
+        const uint8_t* body, size_t len, const char** response, size_t* responseLen);
+static void _onMessage(polip_mqtt_t* mqtt, char* topic, uint8_t* payload, unsigned int length);
+static bool _buildTopic(polip_mqtt_t* mqtt, char* topic, const char* suffix, const char* path = NULL);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_mqtt_initialize(polip_mqtt_t* mqtt) {
+    char topic[POLIP_MQTT_TOPIC_BUFFER_SIZE];
+
+    if (mqtt->client == NULL || mqtt->device == NULL || mqtt->buffer == NULL) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    mqtt->client->setCallback([mqtt](char* topic, uint8_t* payload, unsigned int length) {
+        _onMessage(mqtt, topic, payload, length);
+    });
+
+    if (!_buildTopic(mqtt, topic, "/res/+/+") || !mqtt->client->subscribe(topic)) {
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+    if (mqtt->rpcWorkflow != NULL) {
+        if (!_buildTopic(mqtt, topic, "/rpc") || !mqtt->client->subscribe(topic)) {
+            return POLIP_ERROR_SERVER_ERROR;
+        }
+    }
+
+    mqtt->transport.exchange = _exchange;
+    mqtt->transport.context = mqtt;
+    mqtt->device->transport = &mqtt->transport;
+    return POLIP_OK;
+}
+
+void polip_mqtt_teardown(polip_mqtt_t* mqtt) {
+    if (mqtt->device != NULL && mqtt->device->transport == &mqtt->transport) {
+        mqtt->device->transport = NULL;
+    }
+    mqtt->state.pushPending = false;
+}
+
+polip_ret_code_t polip_mqtt_loop(polip_mqtt_t* mqtt, JsonDocument& doc, const char* timestamp) {
+    mqtt->client->loop();
+
+    if (!mqtt->state.pushPending) {
+        return POLIP_OK;
+    }
+    mqtt->state.pushPending = false;
+
+    // Same trust as a poll response, reject anything not tagged by server.
+    //  Decoded as sent, as for long-poll replies, since tag is recomputed in device encoding
+    bool msgpack = (mqtt->device->encoding == POLIP_ENCODING_MSGPACK);
+    bool msgpackBody = msgpack && !_isJsonBody(mqtt->buffer, mqtt->state.rxLen);
+    if (msgpack && !msgpackBody) {
+        mqtt->device->encoding = POLIP_ENCODING_JSON; // Server does not speak MessagePack
+    }
+
+    doc.clear();
+    DeserializationError err = (msgpackBody)
+        ? deserializeMsgPack(doc, mqtt->buffer, mqtt->state.rxLen)
+        : deserializeJson(doc, mqtt->buffer, mqtt->state.rxLen);
+    if (err) {
+        mqtt->state.dropped++;
+        return POLIP_ERROR_RESPONSE_DESERIALIZATION;
+    }
+
+    if (!mqtt->device->skipTagCheck && !_verifyTag(mqtt->device, doc)) {
+        mqtt->state.dropped++;
+        return POLIP_ERROR_TAG_MISMATCH;
+    }
+
+    mqtt->state.pushes++;
+    return polip_rpc_workflow_poll_event(mqtt->rpcWorkflow, mqtt->device, doc, timestamp);
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static int _exchange(void* context, polip_device_t* dev, const char* path,
+        const uint8_t* body, size_t len, const char** response, size_t* responseLen) {
+    polip_mqtt_t* mqtt = (polip_mqtt_t*)context;
+    char topic[POLIP_MQTT_TOPIC_BUFFER_SIZE];
+    char suffix[16];
+
+    if (strncmp(path, MQTT_PATH_ROOT, strlen(MQTT_PATH_ROOT)) == 0) {
+        path += strlen(MQTT_PATH_ROOT);
+    }
+
+    // Reply must echo sequence, anything else answers an abandoned request
+    mqtt->state.sequence++;
+    snprintf(suffix, sizeof(suffix), "/req/%u", mqtt->state.sequence);
+    if (!_buildTopic(mqtt, topic, suffix, path)) {
+        return -1;
+    }
+
+    if (mqtt->state.pushPending) {
+        mqtt->state.pushPending = false; // Reply reuses buffer, RPCs stay pending on server
+        mqtt->state.dropped++;
+    }
+
+    mqtt->state.replied = false;
+    mqtt->state.awaiting = true;
+    if (!mqtt->client->publish(topic, body, len)) {
+        mqtt->state.awaiting = false;
+        return -1;
+    }
+
+    unsigned long start = millis();
+    while (!mqtt->state.replied && (millis() - start) < mqtt->params.timeout_ms) {
+        if (!mqtt->client->loop()) {
+            break; // Connection lost
+        }
+        yield();
+    }
+    mqtt->state.awaiting = false;
+
+    if (!mqtt->state.replied) {
+        mqtt->state.timeouts++;
+        return -1;
+    }
+
+    mqtt->state.exchanges++;
+    *response = mqtt->buffer;
+    *responseLen = mqtt->state.rxLen;
+    return mqtt->state.code;
+}
+
+static void _onMessage(polip_mqtt_t* mqtt, char* topic, uint8_t* payload, unsigned int length) {
+    char expected[POLIP_MQTT_TOPIC_BUFFER_SIZE];
+
+    if (_buildTopic(mqtt, expected, "/res/") && strncmp(topic, expected, strlen(expected)) == 0) {
+        char* end;
+        unsigned long sequence = strtoul(topic + strlen(expected), &end, 10);
+        if (*end != '/' || !mqtt->state.awaiting || mqtt->state.replied || sequence != mqtt->state.sequence) {
+            mqtt->state.stale++; // Late reply to an abandoned request
+            return;
+        } else if (length > mqtt->bufferLen) {
+            return; // Too large, request times out
+        }
+        memcpy(mqtt->buffer, payload, length);
+        mqtt->state.rxLen = length;
+        mqtt->state.code = atoi(end + 1);
+        mqtt->state.replied = true;
+
+    } else if (_buildTopic(mqtt, expected, "/rpc") && strcmp(topic, expected) == 0) {
+        if (mqtt->state.awaiting || mqtt->state.pushPending || length > mqtt->bufferLen) {
+            mqtt->state.dropped++; // Next poll picks RPCs up instead
+            return;
+        }
+        memcpy(mqtt->buffer, payload, length);
+        mqtt->state.rxLen = length;
+        mqtt->state.pushPending = true;
+    }
+}
+
+static bool _buildTopic(polip_mqtt_t* mqtt, char* topic, const char* suffix, const char* path) {
+    int len = snprintf(topic, POLIP_MQTT_TOPIC_BUFFER_SIZE, "%s%s%s%s", POLIP_MQTT_TOPIC_PREFIX,
+        mqtt->device->serialStr, suffix, (path != NULL) ? path : "");
+    return len > 0 && len < POLIP_MQTT_TOPIC_BUFFER_SIZE;
+}
+
+#endif //POLIP_MQTT_ENABLED
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ * @file polip-mqtt.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional MQTT transport. Requests keep the tagged envelope produced for
+ * HTTP and are published to a per-endpoint topic; the server (or a bridge)
+ * publishes the reply on a response topic whose last level is the HTTP
+ * equivalent status. Each request carries a sequence number that the reply
+ * must echo, so a late reply to a timed-out request is never taken as the
+ * reply to the next one. Topics under POLIP_MQTT_TOPIC_PREFIX for serial <s>:
+ * 
+ *      <s>/req/<seq>/device/v1/state   request, path after "/api"
+ *      <s>/res/<seq>/<code>            reply to request <seq>
+ *      <s>/rpc                         server pushed RPC list, tagged like a poll
+ * 
+ * Pushed RPC lists are verified and handed to polip_rpc_workflow_poll_event.
+ * 
+ * Needs PubSubClient. Include <PubSubClient.h> in sketch before this library
+ * so it is found, otherwise this module compiles to nothing.
+ */
+
+#ifndef POLIP_MQTT_HPP
+#define POLIP_MQTT_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+#include "./polip-rpc-workflow.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Enables MQTT transport, defaults to whether PubSubClient is available
+#ifndef POLIP_MQTT_ENABLED
+#if defined(__has_include)
+#if __has_include(<PubSubClient.h>)
+#define POLIP_MQTT_ENABLED                          (true)
+#endif
+#endif
+#endif
+#ifndef POLIP_MQTT_ENABLED
+#define POLIP_MQTT_ENABLED                          (false)
+#endif
+
+#if POLIP_MQTT_ENABLED
+
+#include <PubSubClient.h>
+
+//! Root of all device topics
+#ifndef POLIP_MQTT_TOPIC_PREFIX
+#define POLIP_MQTT_TOPIC_PREFIX                     "polip/v1/"
+#endif
+
+//! Longest topic built, prefix + serial + path
+#ifndef POLIP_MQTT_TOPIC_BUFFER_SIZE
+#define POLIP_MQTT_TOPIC_BUFFER_SIZE                (128)
+#endif
+
+//! Wait for reply to a published request
+#ifndef POLIP_MQTT_DEFAULT_TIMEOUT_MS
+#define POLIP_MQTT_DEFAULT_TIMEOUT_MS               (5000L)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * MQTT transport context, linked to device by application
+ */
+typedef struct _polip_mqtt {
+
+    /**
+     * Connected client, owned by application. Its buffer size must fit the
+     * largest request / response plus topic.
+     */
+    PubSubClient* client = NULL;
+
+    /**
+     * Device served by this context, one context per device
+     */
+    polip_device_t* device = NULL;
+
+    /**
+     * Optional, receives pushed RPC lists. NULL leaves RPCs to polling.
+     */
+    struct _polip_rpc_workflow* rpcWorkflow = NULL;
+
+    /**
+     * Receive buffer for replies and pushes, must be linked
+     */
+    char* buffer = NULL;
+    uint16_t bufferLen = 0;
+
+    /**
+     * Interface linked into device, filled by initialize
+     */
+    polip_transport_t transport;
+
+    /**
+     * Inner table for parameters used by MQTT transport
+     * Defaults set as defined in struct
+     */
+    struct _polip_mqtt_params {
+        unsigned long timeout_ms = POLIP_MQTT_DEFAULT_TIMEOUT_MS;
+    } params;
+
+    /**
+     * Inner table for state used by MQTT transport
+     */
+    struct _polip_mqtt_state {
+        bool awaiting = false;          //! Request published, reply not yet seen
+        bool replied = false;           //! Reply in buffer
+        bool pushPending = false;       //! Pushed RPC list in buffer
+        uint16_t sequence = 0;          //! Sequence of last request published
+        int code = 0;                   //! Status of reply
+        uint16_t rxLen = 0;             //! Bytes in buffer
+        uint32_t exchanges = 0;         //! Requests answered
+        uint32_t timeouts = 0;          //! Requests unanswered
+        uint32_t stale = 0;             //! Replies not matching awaited request
+        uint32_t pushes = 0;            //! RPC lists delivered
+        uint32_t dropped = 0;           //! Pushes rejected (tag / busy / too large)
+    } state;
+
+} polip_mqtt_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Subscribes device topics on connected client and links transport
+ * into device. Call again after client reconnects.
+ * 
+ * @param mqtt pointer to MQTT context, client / device / buffer linked
+ * @return polip_ret_code_t LIB_REQUEST if not linked; SERVER_ERROR if
+ *      subscribe failed; OK otherwise
+ */
+polip_ret_code_t polip_mqtt_initialize(polip_mqtt_t* mqtt);
+/**
+ * @brief Unlinks transport from device, requests revert to HTTP
+ * 
+ * @param mqtt pointer to MQTT context
+ */
+void polip_mqtt_teardown(polip_mqtt_t* mqtt);
+/**
+ * @brief Services client and delivers any pushed RPC list. Call every loop.
+ * 
+ * @param mqtt pointer to MQTT context
+ * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param timestamp pointer to formatted timestamp string
+ * @return polip_ret_code_t OK if nothing pushed or delivered; TAG_MISMATCH /
+ *      RESPONSE_DESERIALIZATION if push rejected; else from rpc poll event
+ */
+polip_ret_code_t polip_mqtt_loop(polip_mqtt_t* mqtt, JsonDocument& doc, const char* timestamp);
+
+#endif //POLIP_MQTT_ENABLED
+
+//==============================================================================
+
+#endif //POLIP_MQTT_HPP
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ * @file polip-notify.cpp
+ * @author Curt Henrichs
+ * @brief Polip Notify
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib server push channel over Server-Sent Events.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+#include <ESP8266WiFi.h>
+
+#include "./polip-notify.hpp"
+#include "./polip-device-internal.hpp"
+#include "./polip-dns.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define NOTIFY_ENDPOINT                             "/api/device/v1/notify"
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static bool _handleLine(polip_notify_t* notify);
+static unsigned long _reconnectThreshold(polip_notify_t* notify);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_notify_connect(polip_notify_t* notify, polip_device_t* dev, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms) {
+    char host[POLIP_NOTIFY_HOST_BUFFER_SIZE];
+    uint16_t port;
+    bool secure;
+    IPAddress address;
+
+    polip_notify_disconnect(notify);
+    notify->state.connectTimer = currentTime_ms;
+    notify->state.reconnects++;
+    if (notify->state.failures < UINT8_MAX) {
+        notify->state.failures++; // Cleared once server accepts stream
+    }
+
+    if (!_parseServerUrl(_serverUrl(dev), host, sizeof(host), &port, &secure) || secure) {
+        return POLIP_ERROR_LIB_REQUEST; // Plain socket only, polling stays at normal period
+    }
+
+    // Resolve and connect with short bounds, system defaults would stall workflow for seconds
+    bool resolved = (dev->dnsCache != NULL && polip_dns_resolve(dev->dnsCache, host, &address, currentTime_ms))
+        || WiFi.hostByName(host, address, notify->params.connectTimeout);
+    notify->client.setTimeout(notify->params.connectTimeout);
+    if (!resolved || !notify->client.connect(address, port)) {
+        notify->client.stop();
+        return POLIP_ERROR_SERVER_ERROR;
+    }
+
+    // Same envelope as any request so server can authenticate the stream
+    doc.clear();
+    _packRequest(dev, doc, timestamp, 0, true, false);
+    size_t len = _serializeRequest(dev, doc); // Encoding tag was computed over
+
+    // HTTP/1.0 keeps the stream free of chunk framing
+    notify->client.print(F("POST " NOTIFY_ENDPOINT " HTTP/1.0\r\nHost: "));
+    notify->client.print(host);
+    notify->client.print(F("\r\nAccept: text/event-stream\r\nContent-Type: "));
+    notify->client.print((dev->encoding == POLIP_ENCODING_MSGPACK) ? F(MIME_MSGPACK) : F(MIME_JSON));
+    notify->client.print(F("\r\nContent-Length: "));
+    notify->client.print((unsigned long)len);
+    notify->client.print(F("\r\n\r\n"));
+    notify->client.write((const uint8_t*)dev->buffer, len);
+
+    notify->state.connected = true;
+    notify->state.rxTimer = currentTime_ms;
+    return POLIP_OK;
+}
+
+void polip_notify_disconnect(polip_notify_t* notify) {
+    notify->client.stop();
+    notify->state.connected = false;
+    notify->state.headersDone = false;
+    notify->state.hasData = false;
+    notify->state.lineLen = 0;
+}
+
+bool polip_notify_update(polip_notify_t* notify, polip_device_t* dev, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms) {
+
+    if (notify->state.connected && (!notify->client.connected() 
+            || (currentTime_ms - notify->state.rxTimer) >= notify->params.idleTimeout)) {
+        polip_notify_disconnect(notify);
+    }
+
+    if (!notify->state.connected) {
+        if ((currentTime_ms - notify->state.connectTimer) >= _reconnectThreshold(notify)) {
+            polip_notify_connect(notify, dev, doc, timestamp, currentTime_ms);
+        }
+        return false;
+    }
+
+    bool notified = false;
+    while (notify->client.available() > 0) {
+        int c = notify->client.read();
+        if (c < 0) {
+            break;
+        }
+        notify->state.rxTimer = currentTime_ms;
+
+        if (c == '\n') {
+            notify->state.line[notify->state.lineLen] = '\0';
+            if (!_handleLine(notify)) {
+                polip_notify_disconnect(notify); // Rejected by server
+                return notified;
+            }
+            notified |= (notify->state.lineLen == 0 && notify->state.hasData);
+            if (notify->state.lineLen == 0) {
+                notify->state.hasData = false;
+            }
+            notify->state.lineLen = 0;
+        } else if (c != '\r' && notify->state.lineLen < POLIP_NOTIFY_LINE_BUFFER_SIZE - 1) {
+            notify->state.line[notify->state.lineLen++] = (char)c;
+        }
+    }
+
+    if (notified) {
+        notify->state.notifications++;
+    }
+    return notified;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static bool _handleLine(polip_notify_t* notify) {
+    const char* line = notify->state.line;
+
+    if (!notify->state.headersDone) {
+        if (strncmp(line, "HTTP/", 5) == 0) {
+            const char* code = strchr(line, ' ');
+            if (code == NULL || atoi(code + 1) != 200) {
+                return false;
+            }
+            notify->state.failures = 0;
+            return true;
+        }
+        notify->state.headersDone = (notify->state.lineLen == 0);
+        return true;
+    }
+
+    // Only data matters, content is ignored as the poll is authoritative;
+    //  comment lines (":") are keep-alives and only refresh the idle timer
+    if (strncmp(line, "data:", 5) == 0) {
+        notify->state.hasData = true;
+    }
+    return true;
+}
+
+static unsigned long _reconnectThreshold(polip_notify_t* notify) {
+    unsigned long threshold = notify->params.reconnectThreshold;
+    for (uint8_t i = 1; i < notify->state.failures && threshold < notify->params.maxReconnectThreshold; i++) {
+        threshold *= 2;
+    }
+    return (threshold < notify->params.maxReconnectThreshold) ? threshold : notify->params.maxReconnectThreshold;
+}
\ No newline at end of file
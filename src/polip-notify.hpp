@@ -0,0 +1,163 @@
+/**
+ * @file polip-notify.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional server push channel. A long-lived Server-Sent Events stream tells
+ * the device that its state or RPCs changed; the workflow then runs its normal
+ * tagged poll right away, so notifications carry no trusted data and the
+ * existing poll response paths are reused. While the stream is up, periodic
+ * polling drops to a slow fallback.
+ */
+
+#ifndef POLIP_NOTIFY_HPP
+#define POLIP_NOTIFY_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <WiFiClient.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Longest stream line kept, longer lines are truncated
+#ifndef POLIP_NOTIFY_LINE_BUFFER_SIZE
+#define POLIP_NOTIFY_LINE_BUFFER_SIZE               (96)
+#endif
+
+//! Host name buffer for stream connection
+#ifndef POLIP_NOTIFY_HOST_BUFFER_SIZE
+#define POLIP_NOTIFY_HOST_BUFFER_SIZE               (64)
+#endif
+
+//! Poll period while stream is connected
+#ifndef POLIP_NOTIFY_DEFAULT_FALLBACK_POLL_THRESHOLD
+#define POLIP_NOTIFY_DEFAULT_FALLBACK_POLL_THRESHOLD (60000L)
+#endif
+
+//! Wait between connection attempts, doubled per failed attempt
+#ifndef POLIP_NOTIFY_DEFAULT_RECONNECT_THRESHOLD
+#define POLIP_NOTIFY_DEFAULT_RECONNECT_THRESHOLD    (5000L)
+#endif
+
+//! Longest wait between failed connection attempts
+#ifndef POLIP_NOTIFY_DEFAULT_MAX_RECONNECT_THRESHOLD
+#define POLIP_NOTIFY_DEFAULT_MAX_RECONNECT_THRESHOLD (300000L)
+#endif
+
+//! Bound on host lookup and TCP connect, each blocks the workflow
+#ifndef POLIP_NOTIFY_DEFAULT_CONNECT_TIMEOUT
+#define POLIP_NOTIFY_DEFAULT_CONNECT_TIMEOUT        (1000L)
+#endif
+
+//! Stream considered dead without any bytes (server sends keep-alive comments)
+#ifndef POLIP_NOTIFY_DEFAULT_IDLE_TIMEOUT
+#define POLIP_NOTIFY_DEFAULT_IDLE_TIMEOUT           (90000L)
+#endif
+
+//==============================================================================
+//  Preprocessor Macros
+//==============================================================================
+
+#define POLIP_NOTIFY_CONNECTED(notifyPtr) ((notifyPtr)->state.connected)
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Push channel, linked to workflow by application
+ */
+typedef struct _polip_notify {
+
+    /**
+     * Dedicated socket, never shared with request connections
+     */
+    WiFiClient client;
+
+    /**
+     * Inner table for parameters used by push channel
+     * Defaults set as defined in struct
+     */
+    struct _polip_notify_params {
+        unsigned long fallbackPollThreshold = POLIP_NOTIFY_DEFAULT_FALLBACK_POLL_THRESHOLD;
+        unsigned long reconnectThreshold = POLIP_NOTIFY_DEFAULT_RECONNECT_THRESHOLD;
+        unsigned long maxReconnectThreshold = POLIP_NOTIFY_DEFAULT_MAX_RECONNECT_THRESHOLD;
+        unsigned long connectTimeout = POLIP_NOTIFY_DEFAULT_CONNECT_TIMEOUT;
+        unsigned long idleTimeout = POLIP_NOTIFY_DEFAULT_IDLE_TIMEOUT;
+    } params;
+
+    /**
+     * Inner table for state used by push channel
+     */
+    struct _polip_notify_state {
+        bool connected = false;         //! Stream established
+        bool headersDone = false;       //! Past HTTP response headers
+        bool hasData = false;           //! Event in progress carries data
+        unsigned long connectTimer = 0; //! Last connection attempt (ms)
+        unsigned long rxTimer = 0;      //! Last byte received (ms)
+        uint32_t notifications = 0;     //! Events received
+        uint32_t reconnects = 0;        //! Connection attempts
+        uint8_t failures = 0;           //! Attempts since stream last accepted
+        uint16_t lineLen = 0;
+        char line[POLIP_NOTIFY_LINE_BUFFER_SIZE];
+    } state;
+
+} polip_notify_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Opens event stream, authenticated by a tagged request body
+ * 
+ * @param notify pointer to push channel
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer (will clear/replace contents)
+ * @param timestamp pointer to formatted timestamp string
+ * @param currentTime_ms time generated from millis()
+ * @return polip_ret_code_t LIB_REQUEST if server is https (plain socket only);
+ *      SERVER_ERROR if connection failed; OK on success
+ */
+polip_ret_code_t polip_notify_connect(polip_notify_t* notify, polip_device_t* dev, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms);
+/**
+ * @brief Closes event stream
+ * 
+ * @param notify pointer to push channel
+ */
+void polip_notify_disconnect(polip_notify_t* notify);
+/**
+ * @brief Service of push channel, (re)connects when due and parses available
+ * stream bytes. Called by workflow when linked. Only a connection attempt
+ * blocks, for at most connect timeout, and attempts back off exponentially
+ * while the server is unreachable or rejects the stream.
+ * 
+ * @param notify pointer to push channel
+ * @param dev pointer to device
+ * @param doc reference to JSON buffer (will clear/replace contents on connect)
+ * @param timestamp pointer to formatted timestamp string
+ * @param currentTime_ms time generated from millis()
+ * @return bool true if a change notification arrived
+ */
+bool polip_notify_update(polip_notify_t* notify, polip_device_t* dev, 
+        JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms);
+
+//==============================================================================
+
+#endif //POLIP_NOTIFY_HPP
\ No newline at end of file
@@ -15,9 +15,8 @@
 //  Libraries
 //==============================================================================
 
-#include <Arduino.h> //TODO remove
-
 #include "./polip-rpc-workflow.hpp"
+#include "./polip-trace.hpp"
 
 //==============================================================================
 //  Public Function Implementation
@@ -71,13 +70,13 @@ polip_ret_code_t polip_rpc_workflow_periodic_update(polip_rpc_workflow_t* rpcWkO
     bool entryDeleted = false;
     polip_rpc_t *nextEntry = NULL, *entry = rpcWkObj->state._activePtr;
 
-    Serial.println("RPC Periodic Event");
+    POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_RPC, POLIP_TRACE_RPC_PERIODIC, rpcWkObj->state.numActiveRPCs);
 
     while (entry != NULL && !(singleEvent && eventCount >= 1 && polipCode == POLIP_OK)) {
         entryDeleted = false;
 
         if (entry->_checked != rpcWkObj->state._masterCheckedBit && !entryDeleted) {
-            Serial.println("RPC check mismatch");
+            POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_RPC, POLIP_TRACE_RPC_CHECK_MISMATCH, entry->status);
             // RPC entry was not in last server poll list
 
             if (rpcWkObj->hooks.shouldDeleteExtraRPC != NULL) {
@@ -102,7 +101,7 @@ polip_ret_code_t polip_rpc_workflow_periodic_update(polip_rpc_workflow_t* rpcWkO
         }
         
         if (entry->status != entry->_nextStatus && !entryDeleted) {
-            Serial.println("Update server state");
+            POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_RPC, POLIP_TRACE_RPC_UPDATE_STATUS, entry->_nextStatus);
             // Need to update server state
 
             polip_rpc_status_t oldStatus = entry->status;
@@ -117,7 +116,7 @@ polip_ret_code_t polip_rpc_workflow_periodic_update(polip_rpc_workflow_t* rpcWkO
             );
 
             if (polipCode == POLIP_OK) {
-                Serial.println("Push successful");
+                POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_RPC, POLIP_TRACE_RPC_PUSH_OK, entry->status);
 
                 // transition graph to next state, may free
                 if (oldStatus == POLIP_RPC_STATUS_CANCELED) {
@@ -164,7 +163,7 @@ polip_ret_code_t polip_rpc_workflow_periodic_update(polip_rpc_workflow_t* rpcWkO
 polip_ret_code_t polip_rpc_workflow_poll_event(polip_rpc_workflow_t* rpcWkObj, polip_device_t* dev, 
         JsonDocument& doc, const char* timestamp) {
 
-    Serial.println("RPC Poll Event");
+    POLIP_TRACE(POLIP_TRACE_LEVEL_DEBUG, POLIP_TRACE_CAT_RPC, POLIP_TRACE_RPC_POLL, rpcWkObj->state.numActiveRPCs);
 
     // Flipping this state, to catch non-changed rpc._checked fields
     rpcWkObj->state._masterCheckedBit = !rpcWkObj->state._masterCheckedBit;
@@ -327,6 +326,11 @@ polip_rpc_t* polip_rpc_workflow_new_rpc(polip_rpc_workflow_t* rpcWkObj, polip_rp
     strcpy(rpcPtr->uuid, uuid);
     strcpy(rpcPtr->type, type);
     rpcPtr->userContext = NULL;
+    rpcPtr->_createdTime_ms = millis();
+
+    if (rpcWkObj->metrics != NULL) {
+        rpcWkObj->metrics->created++;
+    }
 
     if (rpcWkObj->hooks.newRPC != NULL) {
         rpcWkObj->hooks.newRPC(dev, rpcPtr, paramObj);
@@ -369,6 +373,14 @@ bool polip_rpc_workflow_free_rpc(polip_rpc_workflow_t* rpcWkObj, polip_rpc_t* rp
 
     if (status) {
         rpcWkObj->state.numActiveRPCs--;
+
+        if (rpcWkObj->metrics != NULL) {
+            static const uint32_t bounds[POLIP_STATS_HIST_BUCKETS - 1] = POLIP_RPC_LIFETIME_HIST_BOUNDS;
+            uint32_t lifetime = millis() - rpc->_createdTime_ms;
+            rpcWkObj->metrics->freed[(rpc->status <= _RPC_STATUS_UNKNOWN) ? rpc->status : _RPC_STATUS_UNKNOWN]++;
+            polip_stat_record(&rpcWkObj->metrics->lifetime, lifetime);
+            polip_histogram_record(&rpcWkObj->metrics->lifetimeHistogram, bounds, lifetime);
+        }
     }
 
     return status;
@@ -384,6 +396,40 @@ polip_rpc_t* polip_rpc_workflow_get_rpc_by_uuid(polip_rpc_workflow_t* rpcWkObj,
     return NULL; // Could not find a matching entry
 }
 
+polip_ret_code_t polip_rpc_workflow_metrics_snapshot(polip_rpc_workflow_t* rpcWkObj, JsonObject obj) {
+    if (rpcWkObj->metrics == NULL) {
+        return POLIP_ERROR_WORKFLOW;
+    }
+
+    polip_rpc_workflow_metrics_t* metrics = rpcWkObj->metrics;
+    obj["created"] = metrics->created;
+    obj["active"] = rpcWkObj->state.numActiveRPCs;
+
+    JsonObject freedObj = obj.createNestedObject("freed");
+    for (int i = 0; i < _RPC_STATUS_UNKNOWN; i++) {
+        if (metrics->freed[i] > 0) {
+            freedObj[polip_rpc_status_enum2str((polip_rpc_status_t)i)] = metrics->freed[i];
+        }
+    }
+    if (metrics->freed[_RPC_STATUS_UNKNOWN] > 0) {
+        freedObj["unknown"] = metrics->freed[_RPC_STATUS_UNKNOWN];
+    }
+
+    // [count, min, mean, max] keeps payload compact for sense push
+    JsonArray lifetimeArr = obj.createNestedArray("lifetime");
+    lifetimeArr.add(metrics->lifetime.count);
+    lifetimeArr.add((metrics->lifetime.count > 0) ? metrics->lifetime.min : 0);
+    lifetimeArr.add(polip_stat_mean(&metrics->lifetime));
+    lifetimeArr.add(metrics->lifetime.max);
+
+    JsonArray histArr = obj.createNestedArray("lifetimeHist");
+    for (int i = 0; i < POLIP_STATS_HIST_BUCKETS; i++) {
+        histArr.add(metrics->lifetimeHistogram.counts[i]);
+    }
+
+    return POLIP_OK;
+}
+
 polip_ret_code_t polip_rpc_workflow_push_status(polip_rpc_workflow_t* rpcWkObj, polip_rpc_t* rpc, polip_device_t* dev, 
         JsonDocument& doc, const char* timestamp) {
 
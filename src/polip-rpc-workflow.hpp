@@ -22,6 +22,7 @@
 
 #include "./polip-core.hpp"
 #include "./polip-device.hpp"
+#include "./polip-stats.hpp"
 
 //==============================================================================
 //  Preprocessor Constants
@@ -47,6 +48,11 @@
 #define POLIP_RPC_TYPE_BUFFER_SIZE                  (50)
 #endif
 
+//! Upper bounds of RPC lifetime histogram buckets in ms (POLIP_STATS_HIST_BUCKETS - 1)
+#ifndef POLIP_RPC_LIFETIME_HIST_BOUNDS
+#define POLIP_RPC_LIFETIME_HIST_BOUNDS              {100UL, 500UL, 1000UL, 5000UL, 10000UL, 60000UL, 300000UL}
+#endif
+
 //==============================================================================
 //  Preprocessor Macros
 //==============================================================================
@@ -155,8 +161,23 @@ typedef struct _polip_rpc {
      */
     bool _checked = false;
 
+    /**
+     * Time RPC entered active list (ms), used for lifetime metrics
+     */
+    unsigned long _createdTime_ms = 0;
+
 } polip_rpc_t;
 
+/**
+ * Fixed memory metrics for RPC workflow, linked by application
+ */
+typedef struct _polip_rpc_workflow_metrics {
+    uint32_t created = 0;               //! RPCs added to active list
+    uint32_t freed[_RPC_STATUS_UNKNOWN + 1] = {0}; //! RPCs freed, by last status
+    polip_stat_t lifetime;              //! Time active (ms) min / mean / max
+    polip_histogram_t lifetimeHistogram; //! Time active, see POLIP_RPC_LIFETIME_HIST_BOUNDS
+} polip_rpc_workflow_metrics_t;
+
 /**
  * Object used within workflow routine for RPCs
  */
@@ -167,6 +188,11 @@ typedef struct _polip_rpc_workflow {
      */
     struct _polip_rpc *_allocatedRPCs = NULL;
 
+    /**
+     * Optional pointer to metrics storage, NULL disables metrics
+     */
+    struct _polip_rpc_workflow_metrics *metrics = NULL;
+
     /**
      * Configuration parameters for workflow algorithm
      */
@@ -238,6 +264,8 @@ bool polip_rpc_workflow_free_rpc(polip_rpc_workflow_t* rpcWkObj, polip_rpc_t* rp
 
 polip_rpc_t* polip_rpc_workflow_get_rpc_by_uuid(polip_rpc_workflow_t* rpcWkObj, const char* uuid);
 
+polip_ret_code_t polip_rpc_workflow_metrics_snapshot(polip_rpc_workflow_t* rpcWkObj, JsonObject obj);
+
 polip_ret_code_t polip_rpc_workflow_push_status(polip_rpc_workflow_t* rpcWkObj, polip_rpc_t* rpc, polip_device_t* dev, 
         JsonDocument& doc, const char* timestamp);
 
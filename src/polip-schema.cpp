@@ -0,0 +1,157 @@
+/**
+ * @file polip-schema.cpp
+ * @author Curt Henrichs
+ * @brief Polip Schema
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib schema key dictionary and positional compact encoding.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+
+#include "./polip-schema.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define FNV_OFFSET_BASIS                            (2166136261UL)
+#define FNV_PRIME                                   (16777619UL)
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+//! Request keys indexed by polip_schema_section_t
+static const char* _objectKeys[_POLIP_SCHEMA_SECTION_COUNT] = {
+    "state",
+    "sense"
+};
+
+static const char* _arrayKeys[_POLIP_SCHEMA_SECTION_COUNT] = {
+    "stateValues",
+    "senseValues"
+};
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static uint32_t _fnv1a(uint32_t hash, const char* str);
+static bool _sectionKnown(polip_schema_dict_t* dict, polip_schema_section_t section, JsonObject obj);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_schema_dict_build(polip_schema_dict_t* dict, JsonDocument& doc) {
+    dict->ready = false;
+    dict->hash = FNV_OFFSET_BASIS;
+
+    JsonObject schema = doc.as<JsonObject>();
+    if (doc.containsKey("schema")) {
+        schema = doc["schema"];
+    }
+
+    uint16_t used = 0;
+    for (int s = 0; s < _POLIP_SCHEMA_SECTION_COUNT; s++) {
+        JsonObject section = schema[_objectKeys[s]];
+        if (section.containsKey("properties")) {
+            section = section["properties"]; // JSON schema style
+        }
+
+        dict->counts[s] = 0;
+        for (JsonPair kv : section) {
+            const char* key = kv.key().c_str();
+            size_t len = strlen(key) + 1;
+            if (dict->counts[s] >= POLIP_SCHEMA_MAX_KEYS || used + len > POLIP_SCHEMA_POOL_SIZE) {
+                return POLIP_ERROR_LIB_REQUEST;
+            }
+
+            memcpy(&dict->_pool[used], key, len);
+            dict->_keys[s][dict->counts[s]++] = used;
+            used += len;
+
+            dict->hash = _fnv1a(dict->hash, key);
+            dict->hash = _fnv1a(dict->hash, ",");
+        }
+
+        if (s == POLIP_SCHEMA_SECTION_STATE) {
+            dict->hash = _fnv1a(dict->hash, ";");
+        }
+    }
+
+    dict->ready = true;
+    return POLIP_OK;
+}
+
+bool polip_schema_compact(polip_schema_dict_t* dict, JsonDocument& doc) {
+    if (!dict->ready) {
+        return false;
+    }
+
+    bool compacted = false;
+    for (int s = 0; s < _POLIP_SCHEMA_SECTION_COUNT; s++) {
+        polip_schema_section_t section = (polip_schema_section_t)s;
+        JsonObject obj = doc[_objectKeys[s]];
+        if (obj.isNull() || !_sectionKnown(dict, section, obj)) {
+            continue;
+        }
+
+        // Absent keys are sent as null to hold their position
+        JsonArray arr = doc.createNestedArray(_arrayKeys[s]);
+        bool complete = !arr.isNull();
+        for (uint8_t i = 0; i < dict->counts[s] && complete; i++) {
+            complete = arr.add(obj[(const char*)&dict->_pool[dict->_keys[s][i]]]);
+        }
+        if (complete && !compacted) {
+            doc["schema"] = dict->hash; // Server cannot decode arrays without it
+        }
+
+        if (!complete || doc.overflowed()) {
+            // Out of capacity, removed memory is not reclaimed so keep object as sent
+            doc.remove(_arrayKeys[s]);
+            if (!compacted) {
+                doc.remove("schema");
+            }
+            break;
+        }
+
+        doc.remove(_objectKeys[s]);
+        compacted = true;
+    }
+
+    return compacted;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static uint32_t _fnv1a(uint32_t hash, const char* str) {
+    while (*str != '\0') {
+        hash ^= (uint8_t)(*str++);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool _sectionKnown(polip_schema_dict_t* dict, polip_schema_section_t section, JsonObject obj) {
+    for (JsonPair kv : obj) {
+        bool found = false;
+        for (uint8_t i = 0; i < dict->counts[section] && !found; i++) {
+            found = (0 == strcmp(kv.key().c_str(), &dict->_pool[dict->_keys[section][i]]));
+        }
+
+        if (!found) {
+            return false; // Would be dropped, keep section as object
+        }
+    }
+    return true;
+}
\ No newline at end of file
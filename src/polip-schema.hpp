@@ -0,0 +1,104 @@
+/**
+ * @file polip-schema.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Compact encoding sends state and sense values positionally, in the key 
+ * order of the device schema, instead of spelling out every key. A dictionary
+ * is built once from the polip_getSchema response and identified to the 
+ * server by a hash of its keys:
+ * 
+ *   {"state":{"power":true,"level":3}} -> {"schema":h,"stateValues":[true,3]}
+ * 
+ * The hash is 32-bit FNV-1a over each state key followed by ',', then ';',
+ * then each sense key followed by ','. Sections holding a key missing from the
+ * dictionary are left as objects, so unknown fields are never dropped.
+ */
+
+#ifndef POLIP_SCHEMA_HPP
+#define POLIP_SCHEMA_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ArduinoJson.h>
+
+#include "./polip-core.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Max keys per section (state, sense) held by dictionary
+#ifndef POLIP_SCHEMA_MAX_KEYS
+#define POLIP_SCHEMA_MAX_KEYS                       (32)
+#endif
+
+//! Bytes of key name storage shared by both sections
+#ifndef POLIP_SCHEMA_POOL_SIZE
+#define POLIP_SCHEMA_POOL_SIZE                      (512)
+#endif
+
+//==============================================================================
+//  Enumerated Constants
+//==============================================================================
+
+/**
+ * Sections of a request that can be sent positionally
+ */
+typedef enum _polip_schema_section {
+    POLIP_SCHEMA_SECTION_STATE,
+    POLIP_SCHEMA_SECTION_SENSE,
+    _POLIP_SCHEMA_SECTION_COUNT
+} polip_schema_section_t;
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Key dictionary derived from device schema, linked to device by application
+ */
+typedef struct _polip_schema_dict {
+    bool ready = false;                 //! Set once built, compaction skipped otherwise
+    uint32_t hash = 0;                  //! Identifies key order to server
+    uint8_t counts[_POLIP_SCHEMA_SECTION_COUNT] = {0}; //! Keys per section
+    uint16_t _keys[_POLIP_SCHEMA_SECTION_COUNT][POLIP_SCHEMA_MAX_KEYS]; //! Offsets into pool
+    char _pool[POLIP_SCHEMA_POOL_SIZE]; //! Null terminated key names
+} polip_schema_dict_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Builds dictionary from schema response. Section keys are read from 
+ * schema.state / schema.sense (or their "properties" object) in document order.
+ * 
+ * @param dict pointer to dictionary
+ * @param doc reference to JSON buffer holding polip_getSchema response
+ * @return polip_ret_code_t LIB_REQUEST if schema too large for dictionary; OK on success
+ */
+polip_ret_code_t polip_schema_dict_build(polip_schema_dict_t* dict, JsonDocument& doc);
+/**
+ * @brief Rewrites state / sense objects of a request into positional arrays, 
+ * called by device before packing when dictionary is linked. Document needs 
+ * spare capacity for the arrays, a section that does not fit is left as object.
+ * 
+ * @param dict pointer to dictionary
+ * @param doc reference to JSON buffer holding request body
+ * @return bool true if any section was compacted
+ */
+bool polip_schema_compact(polip_schema_dict_t* dict, JsonDocument& doc);
+
+//==============================================================================
+
+#endif //POLIP_SCHEMA_HPP
\ No newline at end of file
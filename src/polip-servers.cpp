@@ -0,0 +1,155 @@
+/**
+ * @file polip-servers.cpp
+ * @author Curt Henrichs
+ * @brief Polip Servers
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib runtime server selection with health tracking and failover.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <Arduino.h>
+
+#include "./polip-servers.hpp"
+#include "./polip-tls.hpp"
+#include "./polip-device-internal.hpp"
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _record(polip_server_list_t* list, uint8_t index, bool ok, uint32_t latency_ms,
+        unsigned long currentTime_ms);
+static bool _select(polip_server_list_t* list, unsigned long currentTime_ms);
+static bool _eligible(polip_server_list_t* list, uint8_t index, unsigned long currentTime_ms);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_server_list_initialize(polip_server_list_t* list) {
+    if (list->servers == NULL || list->serverCount == 0) {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    for (uint8_t i = 0; i < list->serverCount; i++) {
+        polip_server_t* server = &list->servers[i];
+        if (server->url == NULL || strlen(server->url) > POLIP_SERVER_URL_MAX_LEN) {
+            return POLIP_ERROR_LIB_REQUEST;
+        }
+        server->down = false;
+        server->failures = 0;
+        server->latency_ms = 0;
+    }
+
+    list->active = 0;
+    return POLIP_OK;
+}
+
+bool polip_server_list_record(polip_server_list_t* list, bool ok, uint32_t latency_ms,
+        unsigned long currentTime_ms) {
+    _record(list, list->active, ok, latency_ms, currentTime_ms);
+    return _select(list, currentTime_ms);
+}
+
+polip_ret_code_t polip_server_list_probe(polip_server_list_t* list, polip_tls_t* tls,
+        unsigned long currentTime_ms) {
+    bool healthy = false;
+
+    for (uint8_t i = 0; i < list->serverCount; i++) {
+        if (!_eligible(list, i, currentTime_ms)) {
+            continue;
+        }
+
+        unsigned long start = millis();
+        int code = _healthCheck(list->servers[i].url, tls);
+        _record(list, i, code == 200, millis() - start, currentTime_ms);
+
+        healthy |= !list->servers[i].down;
+    }
+
+    _select(list, currentTime_ms);
+    return (healthy) ? POLIP_OK : POLIP_ERROR_SERVER_ERROR;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _record(polip_server_list_t* list, uint8_t index, bool ok, uint32_t latency_ms,
+        unsigned long currentTime_ms) {
+    polip_server_t* server = &list->servers[index];
+
+    if (ok) {
+        server->down = false;
+        server->failures = 0;
+
+        if (server->latency_ms == 0) {
+            server->latency_ms = latency_ms;
+        } else {
+            int32_t diff = (int32_t)latency_ms - (int32_t)server->latency_ms;
+            server->latency_ms += diff / (1L << list->params.latencyShift);
+        }
+        if (server->latency_ms == 0) {
+            server->latency_ms = 1; // Keep measured distinct from unmeasured
+        }
+
+    } else if (server->down || ++server->failures >= list->params.failoverThreshold) {
+        // Retry of a downed server needs only one failure to stay down
+        server->down = true;
+        server->failures = 0;
+        server->downTimer = currentTime_ms;
+    }
+}
+
+static bool _select(polip_server_list_t* list, unsigned long currentTime_ms) {
+    int best = -1;
+
+    // Measured beats unmeasured, then lowest latency, earliest on ties
+    for (uint8_t i = 0; i < list->serverCount; i++) {
+        if (!_eligible(list, i, currentTime_ms)) {
+            continue;
+        }
+
+        uint32_t latency = list->servers[i].latency_ms;
+        if (best < 0 || (latency != 0 && (list->servers[best].latency_ms == 0
+                || latency < list->servers[best].latency_ms))) {
+            best = i;
+        }
+    }
+
+    bool activeUp = _eligible(list, list->active, currentTime_ms);
+    if (best < 0) {
+        best = (list->active + 1) % list->serverCount; // All down, rotate rather than stall on one
+    } else if (activeUp && best != list->active && list->servers[list->active].latency_ms != 0) {
+        // Stay unless clearly faster, so similar servers do not flap
+        uint64_t bestScaled = (uint64_t)list->servers[best].latency_ms * 100;
+        uint64_t activeScaled = (uint64_t)list->servers[list->active].latency_ms * (100 - list->params.switchMargin);
+        if (bestScaled >= activeScaled) {
+            return false;
+        }
+    }
+
+    if (best == list->active) {
+        return false;
+    }
+
+    if (activeUp) {
+        list->state.switches++;
+    } else {
+        list->state.failovers++;
+    }
+    list->active = best;
+    return true;
+}
+
+static bool _eligible(polip_server_list_t* list, uint8_t index, unsigned long currentTime_ms) {
+    const polip_server_t* server = &list->servers[index];
+    return !server->down || (currentTime_ms - server->downTimer) >= list->params.retryThreshold;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file polip-servers.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional runtime list of ingest servers, replacing the compile-time
+ * POLIP_DEVICE_INGEST_SERVER_URL for devices it is linked to. Each request's
+ * outcome and latency is recorded against the server it went to. Repeated
+ * connection failures or 5xx replies mark a server down and fail over, and
+ * requests otherwise go to the healthy server with the lowest smoothed latency.
+ * Probing runs the health check against every server, so servers not in use
+ * are measured too and downed servers can recover.
+ */
+
+#ifndef POLIP_SERVERS_HPP
+#define POLIP_SERVERS_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./polip-core.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Longest base URL, so every endpoint URI fits POLIP_QUERY_URI_BUFFER_SIZE
+#ifndef POLIP_SERVER_URL_MAX_LEN
+#define POLIP_SERVER_URL_MAX_LEN                    (48)
+#endif
+
+//! Consecutive failures before server is marked down
+#ifndef POLIP_SERVERS_DEFAULT_FAILOVER_THRESHOLD
+#define POLIP_SERVERS_DEFAULT_FAILOVER_THRESHOLD    (3)
+#endif
+
+//! Time a downed server is skipped before being tried again
+#ifndef POLIP_SERVERS_DEFAULT_RETRY_THRESHOLD
+#define POLIP_SERVERS_DEFAULT_RETRY_THRESHOLD       (60000L)
+#endif
+
+//! Smoothing of latency, each sample moves average by 1 / 2^shift
+#ifndef POLIP_SERVERS_DEFAULT_LATENCY_SHIFT
+#define POLIP_SERVERS_DEFAULT_LATENCY_SHIFT         (3)
+#endif
+
+//! Percent faster another server must be before switching to it
+#ifndef POLIP_SERVERS_DEFAULT_SWITCH_MARGIN
+#define POLIP_SERVERS_DEFAULT_SWITCH_MARGIN         (20)
+#endif
+
+//==============================================================================
+//  Preprocessor Macros
+//==============================================================================
+
+#define POLIP_SERVERS_ACTIVE_URL(listPtr) ((listPtr)->servers[(listPtr)->active].url)
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Single ingest server and its observed health
+ */
+typedef struct _polip_server {
+    const char* url = NULL;             //! Base URL, e.g. "http://eu.okospolip.com:3021"
+    bool down = false;                  //! Marked down after repeated failures
+    uint8_t failures = 0;               //! Consecutive failures
+    uint32_t latency_ms = 0;            //! Smoothed request latency, 0 until measured
+    unsigned long downTimer = 0;        //! Marked down (ms)
+} polip_server_t;
+
+/**
+ * Server list, linked to one or more devices by application
+ */
+typedef struct _polip_server_list {
+
+    /**
+     * Array of servers, first is used until others are measured
+     */
+    struct _polip_server* servers = NULL;
+    uint8_t serverCount = 0;
+
+    /**
+     * Index of server requests currently go to
+     */
+    uint8_t active = 0;
+
+    /**
+     * Inner table for parameters used by server selection
+     * Defaults set as defined in struct
+     */
+    struct _polip_server_list_params {
+        uint8_t failoverThreshold = POLIP_SERVERS_DEFAULT_FAILOVER_THRESHOLD;
+        unsigned long retryThreshold = POLIP_SERVERS_DEFAULT_RETRY_THRESHOLD;
+        uint8_t latencyShift = POLIP_SERVERS_DEFAULT_LATENCY_SHIFT;
+        uint8_t switchMargin = POLIP_SERVERS_DEFAULT_SWITCH_MARGIN;
+    } params;
+
+    /**
+     * Inner table for state used by server selection
+     */
+    struct _polip_server_list_state {
+        uint32_t failovers = 0;         //! Switches away from a downed server
+        uint32_t switches = 0;          //! Switches to a faster server
+    } state;
+
+} polip_server_list_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Validates list and resets health, first server becomes active
+ * 
+ * @param list pointer to server list, servers linked
+ * @return polip_ret_code_t LIB_REQUEST if empty or a URL is missing / too long;
+ *      OK otherwise
+ */
+polip_ret_code_t polip_server_list_initialize(polip_server_list_t* list);
+/**
+ * @brief Records outcome of a request to active server and reselects
+ * 
+ * @param list pointer to server list
+ * @param ok false for connection failure or 5xx reply
+ * @param latency_ms time request took
+ * @param currentTime_ms time generated from millis()
+ * @return bool true if active server changed
+ */
+bool polip_server_list_record(polip_server_list_t* list, bool ok, uint32_t latency_ms,
+        unsigned long currentTime_ms);
+/**
+ * @brief Runs health check against every server, except downed ones still
+ * within retry threshold, then reselects. Blocks for one round trip per server.
+ * 
+ * @param list pointer to server list
+ * @param tls optional HTTPS context for https servers
+ * @param currentTime_ms time generated from millis()
+ * @return polip_ret_code_t SERVER_ERROR if no server healthy; OK otherwise
+ */
+polip_ret_code_t polip_server_list_probe(polip_server_list_t* list, struct _polip_tls* tls,
+        unsigned long currentTime_ms);
+
+//==============================================================================
+
+#endif //POLIP_SERVERS_HPP
\ No newline at end of file
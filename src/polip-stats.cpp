@@ -0,0 +1,56 @@
+/**
+ * @file polip-stats.cpp
+ * @author Curt Henrichs
+ * @brief Polip Stats
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib fixed memory aggregates used by instrumentation and metrics.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include "./polip-stats.hpp"
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+void polip_stat_record(polip_stat_t* stat, uint32_t sample) {
+    stat->count++;
+    stat->sum += sample;
+    if (sample < stat->min) {
+        stat->min = sample;
+    }
+    if (sample > stat->max) {
+        stat->max = sample;
+    }
+}
+
+uint32_t polip_stat_mean(const polip_stat_t* stat) {
+    return (stat->count == 0) ? 0 : (uint32_t)(stat->sum / stat->count);
+}
+
+void polip_stat_reset(polip_stat_t* stat) {
+    stat->count = 0;
+    stat->min = UINT32_MAX;
+    stat->max = 0;
+    stat->sum = 0;
+}
+
+void polip_histogram_record(polip_histogram_t* hist, const uint32_t bounds[], uint32_t sample) {
+    unsigned int i = 0;
+    while (i < POLIP_STATS_HIST_BUCKETS - 1 && sample > bounds[i]) {
+        i++;
+    }
+    hist->counts[i]++;
+}
+
+void polip_histogram_reset(polip_histogram_t* hist) {
+    for (unsigned int i = 0; i < POLIP_STATS_HIST_BUCKETS; i++) {
+        hist->counts[i] = 0;
+    }
+}
\ No newline at end of file
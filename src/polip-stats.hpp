@@ -0,0 +1,93 @@
+/**
+ * @file polip-stats.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ */
+
+#ifndef POLIP_STATS_HPP
+#define POLIP_STATS_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Number of buckets in fixed histograms, last bucket catches overflow
+#ifndef POLIP_STATS_HIST_BUCKETS
+#define POLIP_STATS_HIST_BUCKETS                    (8)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Running min / mean / max aggregate
+ */
+typedef struct _polip_stat {
+    uint32_t count = 0;                 //! Samples recorded
+    uint32_t min = UINT32_MAX;          //! Smallest sample, UINT32_MAX if none
+    uint32_t max = 0;                   //! Largest sample
+    uint64_t sum = 0;                   //! Sum of samples, mean = sum / count
+} polip_stat_t;
+
+/**
+ * Fixed bucket histogram, bucket i counts samples <= bounds[i]
+ */
+typedef struct _polip_histogram {
+    uint32_t counts[POLIP_STATS_HIST_BUCKETS] = {0};
+} polip_histogram_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Adds sample to aggregate
+ * 
+ * @param stat pointer to aggregate
+ * @param sample value to record
+ */
+void polip_stat_record(polip_stat_t* stat, uint32_t sample);
+/**
+ * @brief Mean of recorded samples
+ * 
+ * @param stat pointer to aggregate
+ * @return uint32_t mean, 0 if no samples
+ */
+uint32_t polip_stat_mean(const polip_stat_t* stat);
+/**
+ * @brief Clears aggregate
+ * 
+ * @param stat pointer to aggregate
+ */
+void polip_stat_reset(polip_stat_t* stat);
+/**
+ * @brief Adds sample to histogram
+ * 
+ * @param hist pointer to histogram
+ * @param bounds array of POLIP_STATS_HIST_BUCKETS-1 ascending upper bounds
+ * @param sample value to record
+ */
+void polip_histogram_record(polip_histogram_t* hist, const uint32_t bounds[], uint32_t sample);
+/**
+ * @brief Clears histogram
+ * 
+ * @param hist pointer to histogram
+ */
+void polip_histogram_reset(polip_histogram_t* hist);
+
+//==============================================================================
+
+#endif //POLIP_STATS_HPP
\ No newline at end of file
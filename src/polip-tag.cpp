@@ -0,0 +1,98 @@
+/**
+ * @file polip-tag.cpp
+ * @author Curt Henrichs
+ * @brief Polip Tag
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib request tag generation with cached keyed HMAC state.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+
+#include "./polip-tag.hpp"
+#include "./polip-device-internal.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define HMAC_IPAD                                   (0x36)
+#define HMAC_OPAD                                   (0x5C)
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+void polip_tag_init(polip_tag_context_t* ctx, const uint8_t* key, int keyLen) {
+    uint8_t block[SHA256HMAC_BLOCKSIZE];
+    memset(block, 0, sizeof(block));
+
+    // Keys longer than a block are hashed first, per RFC 2104
+    if (keyLen > SHA256HMAC_BLOCKSIZE) {
+        SHA256 keyHash;
+        keyHash.doUpdate(key, keyLen);
+        keyHash.doFinal(block);
+    } else {
+        memcpy(block, key, keyLen);
+    }
+
+    for (int i = 0; i < SHA256HMAC_BLOCKSIZE; i++) {
+        block[i] ^= HMAC_IPAD;
+    }
+    ctx->inner = SHA256();
+    ctx->inner.doUpdate(block, SHA256HMAC_BLOCKSIZE);
+
+    for (int i = 0; i < SHA256HMAC_BLOCKSIZE; i++) {
+        block[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+    }
+    ctx->outer = SHA256();
+    ctx->outer.doUpdate(block, SHA256HMAC_BLOCKSIZE);
+
+    ctx->key = key;
+    ctx->keyLen = keyLen;
+}
+
+void polip_tag_invalidate(polip_tag_context_t* ctx) {
+    ctx->key = NULL;
+    ctx->keyLen = 0;
+}
+
+void polip_tag_compute(polip_tag_context_t* ctx, const char* msg, size_t len, uint8_t out[]) {
+    uint8_t innerDigest[SHA256_SIZE];
+
+    SHA256 inner = ctx->inner;
+    inner.doUpdate(msg, len);
+    inner.doFinal(innerDigest);
+
+    SHA256 outer = ctx->outer;
+    outer.doUpdate(innerDigest, SHA256_SIZE);
+    outer.doFinal(out);
+}
+
+void polip_tag_compute_batch(polip_tag_job_t jobs[], size_t count) {
+    uint8_t authCode[SHA256HMAC_SIZE];
+
+    for (size_t i = 0; i < count; i++) {
+        polip_device_t* dev = jobs[i].dev;
+        polip_tag_context_t* ctx = dev->tagContext;
+
+        if (ctx != NULL) {
+            if (ctx->key == NULL || ctx->key != dev->keyStr || ctx->keyLen != dev->keyStrLen) {
+                polip_tag_init(ctx, dev->keyStr, dev->keyStrLen);
+            }
+            polip_tag_compute(ctx, jobs[i].msg, jobs[i].len, authCode);
+        } else {
+            SHA256HMAC hmac(dev->keyStr, dev->keyStrLen);
+            hmac.doUpdate(jobs[i].msg, jobs[i].len);
+            hmac.doFinal(authCode);
+        }
+
+        _array2string(authCode, SHA256HMAC_SIZE, jobs[i].tag);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file polip-tag.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Request tags are HMAC-SHA256 over the serialized message. The keyed inner
+ * and outer pad blocks depend only on the key, so their hash state is computed
+ * once and copied for each tag, saving two compressions per message.
+ * 
+ * The cached state is rederived when the device key pointer or length changes.
+ * A key rotated in place (same buffer, same length) is not detected, call
+ * polip_tag_invalidate after writing the new key.
+ */
+
+#ifndef POLIP_TAG_HPP
+#define POLIP_TAG_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <ArduinoCrypto.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Characters in hex tag string including terminator
+#define POLIP_TAG_STR_SIZE                          (SHA256HMAC_SIZE*2 + 1)
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Cached keyed HMAC state, linked to device by application
+ */
+typedef struct _polip_tag_context {
+    SHA256 inner;                       //! Hash state after key ^ ipad block
+    SHA256 outer;                       //! Hash state after key ^ opad block
+    const uint8_t* key = NULL;          //! Key state was derived from
+    int keyLen = 0;                     //! Length of key state was derived from
+} polip_tag_context_t;
+
+/**
+ * Single entry of a batched tag computation
+ */
+typedef struct _polip_tag_job {
+    polip_device_t* dev;                //! Device whose key signs message
+    const char* msg;                    //! Serialized message
+    size_t len;                         //! Length of message
+    char tag[POLIP_TAG_STR_SIZE];       //! Output hex tag
+} polip_tag_job_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Derives keyed pad state, called automatically when device key changes
+ * 
+ * @param ctx pointer to context
+ * @param key pointer to key bytes
+ * @param keyLen length of key
+ */
+void polip_tag_init(polip_tag_context_t* ctx, const uint8_t* key, int keyLen);
+/**
+ * @brief Discards keyed pad state, next tag rederives it from device key.
+ * Must be called whenever key bytes change in place.
+ * 
+ * @param ctx pointer to context
+ */
+void polip_tag_invalidate(polip_tag_context_t* ctx);
+/**
+ * @brief Computes HMAC-SHA256 of message from cached keyed state
+ * 
+ * @param ctx pointer to initialized context
+ * @param msg pointer to message
+ * @param len length of message
+ * @param out output, SHA256HMAC_SIZE bytes
+ */
+void polip_tag_compute(polip_tag_context_t* ctx, const char* msg, size_t len, uint8_t out[]);
+/**
+ * @brief Computes hex tags for several messages, for example when a gateway
+ * signs for many devices. Devices with a linked tag context reuse its keyed
+ * state, others fall back to a full HMAC.
+ * 
+ * @param jobs array of jobs, tag written in place
+ * @param count number of jobs
+ */
+void polip_tag_compute_batch(polip_tag_job_t jobs[], size_t count);
+
+//==============================================================================
+
+#endif //POLIP_TAG_HPP
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * @file polip-tls.cpp
+ * @author Curt Henrichs
+ * @brief Polip TLS
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib HTTPS socket setup and session persistence.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <string.h>
+#include <Arduino.h>
+
+#include "./polip-tls.hpp"
+#include "./polip-compress.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define TLS_SESSION_MAGIC                           (0x504C5331UL) // "PLS1"
+#define TLS_FULL_RECORD_SIZE                        (16384)
+
+//==============================================================================
+//  Data Structure Declaration
+//==============================================================================
+
+/**
+ * Record layout as stored in RTC memory
+ */
+typedef struct _session_record {
+    uint32_t magic;                     //! Marks record as valid
+    uint32_t crc;                       //! Over parameters, RTC memory survives sleep not power loss
+    br_ssl_session_parameters params;   //! BearSSL session ID and master secret
+} _session_record_t;
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+polip_ret_code_t polip_tls_initialize(polip_tls_t* tls, const char* host, uint16_t port) {
+    if (tls->insecure) {
+        tls->client.setInsecure();
+    } else if (tls->trustAnchors != NULL) {
+        tls->client.setTrustAnchors(tls->trustAnchors);
+    } else if (tls->fingerprint != NULL) {
+        tls->client.setFingerprint(tls->fingerprint);
+    } else {
+        return POLIP_ERROR_LIB_REQUEST;
+    }
+
+    // Small receive buffer only works if server agrees to shorter records
+    uint16_t rx = tls->params.rxBufferSize;
+    if (rx < TLS_FULL_RECORD_SIZE && !BearSSL::WiFiClientSecure::probeMaxFragmentLength(host, port, rx)) {
+        rx = TLS_FULL_RECORD_SIZE;
+    }
+    tls->client.setBufferSizes(rx, tls->params.txBufferSize);
+
+    tls->client.setSession(&tls->session);
+    return POLIP_OK;
+}
+
+bool polip_tls_save_session(polip_tls_t* tls) {
+    _session_record_t record;
+    memcpy(&record.params, tls->session.getSession(), sizeof(record.params));
+    record.magic = TLS_SESSION_MAGIC;
+    record.crc = polip_crc32(0, (const uint8_t*)&record.params, sizeof(record.params));
+
+    return ESP.rtcUserMemoryWrite(POLIP_TLS_RTC_SESSION_OFFSET, (uint32_t*)&record, sizeof(record));
+}
+
+bool polip_tls_load_session(polip_tls_t* tls) {
+    _session_record_t record;
+    if (!ESP.rtcUserMemoryRead(POLIP_TLS_RTC_SESSION_OFFSET, (uint32_t*)&record, sizeof(record))) {
+        return false;
+    } else if (record.magic != TLS_SESSION_MAGIC
+            || record.crc != polip_crc32(0, (const uint8_t*)&record.params, sizeof(record.params))) {
+        return false; // Cold boot, RTC memory is random
+    }
+
+    memcpy(tls->session.getSession(), &record.params, sizeof(record.params));
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file polip-tls.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ * 
+ * Optional HTTPS context for an "https://" server URL (ingest port 3033).
+ * A full TLS handshake takes seconds on an ESP8266, so the negotiated session
+ * is kept and offered on every reconnect; the server resumes it with an
+ * abbreviated handshake. The session can be parked in RTC memory across deep
+ * sleep so the first request after waking resumes as well.
+ */
+
+#ifndef POLIP_TLS_HPP
+#define POLIP_TLS_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <WiFiClientSecure.h>
+
+#include "./polip-core.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! TLS receive buffer, smaller than 16k only if server supports max fragment length
+#ifndef POLIP_TLS_DEFAULT_RX_BUFFER_SIZE
+#define POLIP_TLS_DEFAULT_RX_BUFFER_SIZE            (1024)
+#endif
+
+//! TLS transmit buffer
+#ifndef POLIP_TLS_DEFAULT_TX_BUFFER_SIZE
+#define POLIP_TLS_DEFAULT_TX_BUFFER_SIZE            (1024)
+#endif
+
+//! RTC user memory block (4 bytes each) where session is parked across deep sleep
+#ifndef POLIP_TLS_RTC_SESSION_OFFSET
+#define POLIP_TLS_RTC_SESSION_OFFSET                (0)
+#endif
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * HTTPS context, linked to one or more devices by application
+ */
+typedef struct _polip_tls {
+
+    /**
+     * Secure socket, used in place of plain socket for all requests
+     */
+    BearSSL::WiFiClientSecure client;
+
+    /**
+     * Negotiated session, offered for resumption on every connect
+     */
+    BearSSL::Session session;
+
+    /**
+     * Server validation, one of trust anchors or fingerprint must be set
+     * unless insecure
+     */
+    const BearSSL::X509List* trustAnchors = NULL;
+    const char* fingerprint = NULL;     //! SHA-1 of server certificate, "AA:BB:..."
+    bool insecure = false;              //! Skips validation, for test servers only
+
+    /**
+     * Inner table for parameters used by TLS context
+     * Defaults set as defined in struct
+     */
+    struct _polip_tls_params {
+        uint16_t rxBufferSize = POLIP_TLS_DEFAULT_RX_BUFFER_SIZE;
+        uint16_t txBufferSize = POLIP_TLS_DEFAULT_TX_BUFFER_SIZE;
+    } params;
+
+} polip_tls_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Applies validation, buffer sizes, and session cache to socket. Call
+ * once before linking to device, after restoring a parked session if any.
+ * 
+ * @param tls pointer to TLS context
+ * @param host server host, used to probe max fragment length support
+ * @param port server port
+ * @return polip_ret_code_t LIB_REQUEST if no validation configured; OK otherwise
+ */
+polip_ret_code_t polip_tls_initialize(polip_tls_t* tls, const char* host, uint16_t port);
+/**
+ * @brief Parks current session in RTC user memory, call before deep sleep
+ * 
+ * @param tls pointer to TLS context
+ * @return bool true if written
+ */
+bool polip_tls_save_session(polip_tls_t* tls);
+/**
+ * @brief Restores session parked before deep sleep
+ * 
+ * @param tls pointer to TLS context
+ * @return bool true if a valid session was restored
+ */
+bool polip_tls_load_session(polip_tls_t* tls);
+
+//==============================================================================
+
+#endif //POLIP_TLS_HPP
\ No newline at end of file
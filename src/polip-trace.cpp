@@ -0,0 +1,111 @@
+/**
+ * @file polip-trace.cpp
+ * @author Curt Henrichs
+ * @brief Polip Trace
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib trace points are recorded as compact binary events into a RAM 
+ * ring buffer instead of blocking on serial. Entire module is compiled out
+ * when trace level is none.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include "./polip-trace.hpp"
+
+#if POLIP_TRACE_LEVEL > POLIP_TRACE_LEVEL_NONE
+
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+static polip_trace_event_t _events[POLIP_TRACE_BUFFER_SIZE];
+static unsigned int _head = 0;          //! Next slot to write
+static unsigned int _count = 0;         //! Events held
+static unsigned long _dropped = 0;      //! Events overwritten unread
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+void polip_trace_record(uint8_t id, uint8_t category, uint16_t arg) {
+    polip_trace_event_t* evt = &_events[_head];
+    evt->time_us = micros();
+    evt->id = id;
+    evt->category = category;
+    evt->arg = arg;
+
+    _head = (_head + 1) % POLIP_TRACE_BUFFER_SIZE;
+    if (_count < POLIP_TRACE_BUFFER_SIZE) {
+        _count++;
+    } else {
+        _dropped++;
+    }
+}
+
+bool polip_trace_read(polip_trace_event_t* evt) {
+    if (_count == 0) {
+        return false;
+    }
+
+    unsigned int tail = (_head + POLIP_TRACE_BUFFER_SIZE - _count) % POLIP_TRACE_BUFFER_SIZE;
+    *evt = _events[tail];
+    _count--;
+    return true;
+}
+
+unsigned int polip_trace_count() {
+    return _count;
+}
+
+unsigned long polip_trace_dropped() {
+    return _dropped;
+}
+
+void polip_trace_clear() {
+    _count = 0;
+    _dropped = 0;
+}
+
+void polip_trace_dump(Print& out) {
+    polip_trace_event_t evt;
+    while (polip_trace_read(&evt)) {
+        out.print(evt.time_us);
+        out.print(' ');
+        out.print(evt.category);
+        out.print(' ');
+        out.print(evt.id);
+        out.print(' ');
+        out.println(evt.arg);
+    }
+}
+
+#else
+
+//==============================================================================
+//  Public Function Implementation (tracing disabled)
+//==============================================================================
+
+void polip_trace_record(uint8_t id, uint8_t category, uint16_t arg) {}
+
+bool polip_trace_read(polip_trace_event_t* evt) {
+    return false;
+}
+
+unsigned int polip_trace_count() {
+    return 0;
+}
+
+unsigned long polip_trace_dropped() {
+    return 0;
+}
+
+void polip_trace_clear() {}
+
+void polip_trace_dump(Print& out) {}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+/**
+ * @file polip-trace.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ */
+
+#ifndef POLIP_TRACE_HPP
+#define POLIP_TRACE_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <Arduino.h>
+
+#include "./polip-core.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! Trace levels, events above configured level are compiled out
+#define POLIP_TRACE_LEVEL_NONE                      (0)
+#define POLIP_TRACE_LEVEL_ERROR                     (1)
+#define POLIP_TRACE_LEVEL_INFO                      (2)
+#define POLIP_TRACE_LEVEL_DEBUG                     (3)
+
+//! Trace categories, events outside configured mask are compiled out
+#define POLIP_TRACE_CAT_DEVICE                      (0x01)
+#define POLIP_TRACE_CAT_WORKFLOW                    (0x02)
+#define POLIP_TRACE_CAT_RPC                         (0x04)
+
+//! Compile-time trace level, NONE removes all trace points
+#ifndef POLIP_TRACE_LEVEL
+#if POLIP_VERBOSE_DEBUG
+#define POLIP_TRACE_LEVEL                           POLIP_TRACE_LEVEL_DEBUG
+#else
+#define POLIP_TRACE_LEVEL                           POLIP_TRACE_LEVEL_NONE
+#endif
+#endif
+
+//! Compile-time mask of trace categories to keep
+#ifndef POLIP_TRACE_CATEGORIES
+#define POLIP_TRACE_CATEGORIES                      (0xFF)
+#endif
+
+//! Number of events held in RAM ring buffer, oldest overwritten when full
+#ifndef POLIP_TRACE_BUFFER_SIZE
+#define POLIP_TRACE_BUFFER_SIZE                     (64)
+#endif
+
+//==============================================================================
+//  Preprocessor Macros
+//==============================================================================
+
+#if POLIP_TRACE_LEVEL > POLIP_TRACE_LEVEL_NONE
+
+#define POLIP_TRACE(level, category, id, arg) {                                 \
+    if ((level) <= POLIP_TRACE_LEVEL && ((category) & POLIP_TRACE_CATEGORIES)) {\
+        polip_trace_record((id), (category), (uint16_t)(arg));                  \
+    }                                                                           \
+}
+
+#else
+
+#define POLIP_TRACE(level, category, id, arg) {                                 \
+    (void)sizeof(arg); /* Unevaluated, silences unused warnings */              \
+}
+
+#endif
+
+//==============================================================================
+//  Enumerated Constants
+//==============================================================================
+
+/**
+ * Trace points within library
+ */
+typedef enum _polip_trace_id {
+    POLIP_TRACE_REQUEST_TX,             //! arg = request length
+    POLIP_TRACE_REQUEST_RX,             //! arg = HTTP code
+    POLIP_TRACE_RPC_PERIODIC,           //! arg = active RPCs
+    POLIP_TRACE_RPC_CHECK_MISMATCH,     //! arg = RPC status
+    POLIP_TRACE_RPC_UPDATE_STATUS,      //! arg = next RPC status
+    POLIP_TRACE_RPC_PUSH_OK,            //! arg = RPC status
+    POLIP_TRACE_RPC_POLL                //! arg = active RPCs
+} polip_trace_id_t;
+
+//==============================================================================
+//  Public Data Structure Declaration
+//==============================================================================
+
+/**
+ * Compact binary trace event
+ */
+typedef struct _polip_trace_event {
+    uint32_t time_us;                   //! micros() when recorded
+    uint8_t id;                         //! polip_trace_id_t
+    uint8_t category;                   //! POLIP_TRACE_CAT_*
+    uint16_t arg;                       //! Event specific argument
+} polip_trace_event_t;
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Records event into ring buffer (use POLIP_TRACE macro instead)
+ * 
+ * @param id trace point identifier
+ * @param category trace category
+ * @param arg event specific argument
+ */
+void polip_trace_record(uint8_t id, uint8_t category, uint16_t arg);
+/**
+ * @brief Pops oldest event from ring buffer
+ * 
+ * @param evt pointer to store event
+ * @return bool true if event was available
+ */
+bool polip_trace_read(polip_trace_event_t* evt);
+/**
+ * @brief Number of events currently in ring buffer
+ * 
+ * @return unsigned int count
+ */
+unsigned int polip_trace_count();
+/**
+ * @brief Number of events overwritten before being read
+ * 
+ * @return unsigned long count
+ */
+unsigned long polip_trace_dropped();
+/**
+ * @brief Discards all events in ring buffer
+ */
+void polip_trace_clear();
+/**
+ * @brief Drains ring buffer as text lines, call outside of time critical code
+ * 
+ * @param out reference to print sink (ex. Serial)
+ */
+void polip_trace_dump(Print& out);
+
+//==============================================================================
+
+#endif //POLIP_TRACE_HPP
\ No newline at end of file
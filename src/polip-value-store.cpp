@@ -0,0 +1,142 @@
+/**
+ * @file polip-value-store.cpp
+ * @author Curt Henrichs
+ * @brief Polip Value Store
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib persistence of the message identifier value so the first request
+ * after boot does not need to resync with the server.
+ */
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdio.h>
+#include <string.h>
+
+#include "./polip-value-store.hpp"
+#include "./polip-compress.hpp"
+
+#if defined(ARDUINO)
+#include <LittleFS.h>
+#endif
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+#define VALUE_STORE_MAGIC                           (0x504C5631UL) // "PLV1"
+
+//==============================================================================
+//  Data Structure Declaration
+//==============================================================================
+
+/**
+ * Record layout as stored in file
+ */
+typedef struct _value_record {
+    uint32_t magic;                     //! Marks record as valid
+    uint32_t value;                     //! Value to start at on boot
+    uint32_t check;                     //! Inverted value, catches torn writes
+    uint8_t window;                     //! Negotiated value window
+} _value_record_t;
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _recordPath(polip_device_t* dev, char* path);
+static bool _readRecord(const char* path, _value_record_t* record);
+static bool _writeRecord(const char* path, const _value_record_t* record);
+
+//==============================================================================
+//  Public Function Implementation
+//==============================================================================
+
+bool polip_value_store_load_file(polip_device_t* dev, uint32_t* value, uint8_t* window) {
+    char path[POLIP_VALUE_STORE_PATH_BUFFER_SIZE];
+    _recordPath(dev, path);
+
+    _value_record_t record;
+    if (!_readRecord(path, &record)) {
+        return false;
+    } else if (record.magic != VALUE_STORE_MAGIC || record.check != ~record.value) {
+        return false;
+    }
+
+    *value = record.value;
+    *window = record.window;
+    return true;
+}
+
+bool polip_value_store_save_file(polip_device_t* dev, uint32_t value, uint8_t window) {
+    char path[POLIP_VALUE_STORE_PATH_BUFFER_SIZE];
+    _recordPath(dev, path);
+
+    _value_record_t record;
+    record.magic = VALUE_STORE_MAGIC;
+    record.value = value;
+    record.check = ~value;
+    record.window = window;
+    return _writeRecord(path, &record);
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _recordPath(polip_device_t* dev, char* path) {
+    // Hashed since serials can exceed filesystem name limits
+    const char* serial = (dev->serialStr != NULL) ? dev->serialStr : "";
+    uint32_t hash = polip_crc32(0, (const uint8_t*)serial, strlen(serial));
+    snprintf(path, POLIP_VALUE_STORE_PATH_BUFFER_SIZE, POLIP_VALUE_STORE_PATH_FORMAT, (unsigned long)hash);
+}
+
+#if defined(ARDUINO)
+
+static bool _readRecord(const char* path, _value_record_t* record) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+    size_t len = file.read((uint8_t*)record, sizeof(_value_record_t));
+    file.close();
+    return len == sizeof(_value_record_t);
+}
+
+static bool _writeRecord(const char* path, const _value_record_t* record) {
+    File file = LittleFS.open(path, "w");
+    if (!file) {
+        return false;
+    }
+    size_t len = file.write((const uint8_t*)record, sizeof(_value_record_t));
+    file.close();
+    return len == sizeof(_value_record_t);
+}
+
+#else
+
+static bool _readRecord(const char* path, _value_record_t* record) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    size_t len = fread(record, 1, sizeof(_value_record_t), file);
+    fclose(file);
+    return len == sizeof(_value_record_t);
+}
+
+static bool _writeRecord(const char* path, const _value_record_t* record) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    size_t len = fwrite(record, 1, sizeof(_value_record_t), file);
+    fclose(file);
+    return len == sizeof(_value_record_t);
+}
+
+#endif
\ No newline at end of file
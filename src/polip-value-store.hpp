@@ -0,0 +1,76 @@
+/**
+ * @file polip-value-store.hpp
+ * @author Curt Henrichs
+ * @brief Polip Client
+ * @version 0.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2022
+ * 
+ * Polip-lib to communicate with Okos Polip home automation server.
+ */
+
+#ifndef POLIP_VALUE_STORE_HPP
+#define POLIP_VALUE_STORE_HPP
+
+//==============================================================================
+//  Libraries
+//==============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./polip-core.hpp"
+#include "./polip-device.hpp"
+
+//==============================================================================
+//  Preprocessor Constants
+//==============================================================================
+
+//! File used to persist message identifier value (LittleFS on device, file on host)
+//! Formatted with CRC-32 of device serial, so devices sharing a filesystem keep separate counters
+#ifndef POLIP_VALUE_STORE_PATH_FORMAT
+#define POLIP_VALUE_STORE_PATH_FORMAT               "/polip-value-%08lx.bin"
+#endif
+
+//! Buffer size of formatted path
+#ifndef POLIP_VALUE_STORE_PATH_BUFFER_SIZE
+#define POLIP_VALUE_STORE_PATH_BUFFER_SIZE          (32)
+#endif
+
+//==============================================================================
+//  Preprocessor Macros
+//==============================================================================
+
+#define POLIP_VALUE_STORE_ASSIGN_FILE_HOOKS(devPtr) {                           \
+    (devPtr)->loadValueCb = polip_value_store_load_file;                        \
+    (devPtr)->saveValueCb = polip_value_store_save_file;                        \
+}
+
+//==============================================================================
+//  Public Function Prototypes
+//==============================================================================
+
+/**
+ * @brief Loads persisted value from file, filesystem must already be mounted
+ * Usable as device loadValueCb.
+ * 
+ * @param dev pointer to device
+ * @param value pointer to store restored value
+ * @param window pointer to store restored value window
+ * @return bool true if a valid record was read
+ */
+bool polip_value_store_load_file(polip_device_t* dev, uint32_t* value, uint8_t* window);
+/**
+ * @brief Saves value to file, filesystem must already be mounted
+ * Usable as device saveValueCb.
+ * 
+ * @param dev pointer to device
+ * @param value value the next boot should start at
+ * @param window negotiated value window
+ * @return bool true if record was written
+ */
+bool polip_value_store_save_file(polip_device_t* dev, uint32_t value, uint8_t window);
+
+//==============================================================================
+
+#endif //POLIP_VALUE_STORE_HPP
\ No newline at end of file
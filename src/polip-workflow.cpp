@@ -20,20 +20,30 @@
 //  Preprocessor Macro Declaration
 //==============================================================================
 
-#define WORKFLOW_EVENT_TEMPLATE(_condition_, _setup_, _req_, _res_,                 \
+#define WORKFLOW_EVENT_TEMPLATE(_condition_, _setup_, _req_, _res_, _unmod_,       \
         wkObjPtr, doc, eventCount, valueRetry, source, retStatus) {                 \
     if ((_condition_) && !(wkObj->params.onlyOneEvent                               \
                       && (wkObj->flags.getValue && !valueRetry)                     \
-                      && (eventCount >= 1))) {                                      \
+                      && (eventCount >= 1))                                         \
+            && !(wkObj->params.maxEventsPerUpdate != 0                              \
+                      && eventCount >= wkObj->params.maxEventsPerUpdate)) {         \
         doc.clear();                                                                \
         _setup_;                                                                    \
+        unsigned long eventStart_us = micros();                                     \
         polip_ret_code_t polipCode = _req_;                                         \
+        _recordEvent((wkObjPtr), source, polipCode, micros() - eventStart_us);      \
         if (polipCode == POLIP_ERROR_VALUE_MISMATCH && valueRetry) {                \
             (wkObjPtr)->flags.getValue = true;                                      \
+            if ((wkObjPtr)->metrics != NULL) {                                      \
+                (wkObjPtr)->metrics->valueResyncs++;                                \
+            }                                                                       \
         } else if (polipCode == POLIP_OK) {                                         \
             _res_;                                                                  \
+        } else if (polipCode == POLIP_OK_NOT_MODIFIED) {                            \
+            _unmod_;                                                                \
         } else {                                                                    \
             (wkObjPtr)->flags.error = polipCode;                                    \
+            (wkObjPtr)->state.lastError = polipCode;                                \
             retStatus = POLIP_ERROR_WORKFLOW;                                       \
             if ((wkObjPtr)->hooks.workflowErrorCb != NULL) {                        \
                 (wkObjPtr)->hooks.workflowErrorCb((wkObjPtr)->device, doc, source, polipCode); \
@@ -44,6 +54,27 @@
     }                                                                               \
 }
 
+//==============================================================================
+//  Private Data
+//==============================================================================
+
+//! Keys for metrics snapshot, indexed by polip_workflow_source_t
+static const char* _sourceNames[_POLIP_WORKFLOW_SOURCE_COUNT] = {
+    "pushState",
+    "pollState",
+    "getValue",
+    "pushSense",
+    "pushRPC",
+    "exchange"
+};
+
+//==============================================================================
+//  Private Function Prototypes
+//==============================================================================
+
+static void _recordEvent(polip_workflow_t* wkObj, polip_workflow_source_t source, 
+        polip_ret_code_t code, unsigned long duration_us);
+
 //==============================================================================
 //  Public Function Implementation
 //==============================================================================
@@ -57,6 +88,11 @@ polip_ret_code_t polip_workflow_initialize(polip_workflow_t* wkObj, unsigned lon
     wkObj->state.pollTimer = currentTime_ms;
     wkObj->state.senseTimer = currentTime_ms;
 
+    if (wkObj->device != NULL && wkObj->device->loadValueCb != NULL) {
+        // Failure is fine, first request will trigger resync
+        polip_restoreValue(wkObj->device);
+    }
+
     polip_ret_code_t status = POLIP_OK;
     if (wkObj->rpcWorkflow != NULL) {
         status = polip_rpc_workflow_initialize(wkObj->rpcWorkflow);
@@ -75,6 +111,12 @@ polip_ret_code_t polip_workflow_teardown(polip_workflow_t* wkObj) {
     if (wkObj->rpcWorkflow != NULL) {
         status = polip_rpc_workflow_teardown(wkObj->rpcWorkflow);
     }
+    if (wkObj->notify != NULL) {
+        polip_notify_disconnect(wkObj->notify);
+    }
+    if (wkObj->longPoll != NULL && wkObj->device != NULL) {
+        polip_longpoll_cancel(wkObj->longPoll, wkObj->device);
+    }
     return status;
 }
 
@@ -82,6 +124,34 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
         JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms) {
     polip_ret_code_t retStatus = POLIP_OK;
     unsigned int eventCount = 0;
+    wkObj->state.lastError = POLIP_OK; // Unlike flags.error, not sticky across calls
+
+    // Push channel turns periodic polling into a slow fallback
+    unsigned long pollThreshold = wkObj->params.pollStateTimeThreshold;
+    if (wkObj->notify != NULL) {
+        bool notified = polip_notify_update(wkObj->notify, wkObj->device, doc, timestamp, currentTime_ms);
+        if (POLIP_NOTIFY_CONNECTED(wkObj->notify)) {
+            pollThreshold = wkObj->notify->params.fallbackPollThreshold;
+        }
+        if (notified) {
+            // Poll stays due until one succeeds, even if other events run first
+            wkObj->state.pollTimer = currentTime_ms - pollThreshold;
+        }
+    }
+
+    // Long-poll in flight replaces timed polling, falls back if it cannot run
+    bool longPollDone = false;
+    if (wkObj->longPoll != NULL) {
+        longPollDone = polip_longpoll_update(wkObj->longPoll, wkObj->device, currentTime_ms);
+    }
+    bool longPolling = (wkObj->longPoll != NULL && POLIP_LONGPOLL_IN_FLIGHT(wkObj->longPoll));
+
+    // Sections due for a combined exchange
+    bool exchangeState = wkObj->params.combinedExchange && wkObj->flags.stateChanged;
+    bool exchangePoll = wkObj->params.combinedExchange && !longPolling
+            && ((currentTime_ms - wkObj->state.pollTimer) >= pollThreshold);
+    bool exchangeSense = wkObj->params.combinedExchange && (wkObj->flags.senseChanged 
+            || (wkObj->params.pushSensePeriodic && (currentTime_ms - wkObj->state.senseTimer) >= wkObj->params.pushSenseTimeThreshold));
 
     // Push RPC action to server
     WORKFLOW_EVENT_TEMPLATE(
@@ -95,17 +165,105 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
                 wkObj->device,
                 doc,
                 timestamp,
-                wkObj->params.onlyOneEvent
+                wkObj->params.onlyOneEvent || wkObj->params.maxEventsPerUpdate == 1
             )
         ),
-        {}, 
-        wkObj,doc, eventCount, true, POLIP_WORKFLOW_PUSH_STATE, retStatus
+        {}, {},
+        wkObj,doc, eventCount, true, POLIP_WORKFLOW_PUSH_RPC, retStatus
+    );
+
+    // Push state, poll, and push sense to server in one request
+    WORKFLOW_EVENT_TEMPLATE(
+        (
+            exchangeState || exchangePoll || exchangeSense
+        ), {
+            if (exchangeState && wkObj->hooks.pushStateSetupCb != NULL) {
+                wkObj->hooks.pushStateSetupCb(wkObj->device, doc);
+            }
+            if (exchangeSense && wkObj->hooks.pushSenseSetupCb != NULL) {
+                wkObj->hooks.pushSenseSetupCb(wkObj->device, doc);
+            }
+        }, (
+            polip_exchange(
+                wkObj->device,
+                doc,
+                timestamp,
+                exchangePoll,
+                wkObj->params.pollState,
+                wkObj->params.pollManufacturer,
+                (wkObj->rpcWorkflow != NULL)
+            )
+        ), {
+            // Combined response is routed to each hook of the sections sent
+            if (exchangeState) {
+                wkObj->flags.stateChanged = false;
+                wkObj->state.pollTimer = currentTime_ms;
+                if (wkObj->hooks.pushStateRespCb != NULL) {
+                    wkObj->hooks.pushStateRespCb(wkObj->device, doc);
+                }
+            }
+
+            if (exchangePoll) {
+                wkObj->state.pollTimer = currentTime_ms;
+
+                if (wkObj->hooks.pollStateRespCb != NULL) {
+                    wkObj->hooks.pollStateRespCb(wkObj->device, doc);
+                }
+
+                if (wkObj->rpcWorkflow != NULL) {
+                    retStatus = polip_rpc_workflow_poll_event(
+                        wkObj->rpcWorkflow, 
+                        wkObj->device, 
+                        doc, 
+                        timestamp
+                    );
+                }
+            }
+
+            if (exchangeSense) {
+                wkObj->state.senseTimer = currentTime_ms;
+                if (wkObj->hooks.pushSenseRespCb != NULL) {
+                    wkObj->hooks.pushSenseRespCb(wkObj->device, doc);
+                }
+            }
+        }, {}, wkObj,doc, eventCount, true, POLIP_WORKFLOW_EXCHANGE, retStatus
+    );
+
+    // Complete long-poll answered by server
+    WORKFLOW_EVENT_TEMPLATE(
+        (
+            longPollDone
+        ), {}, (
+            polip_longpoll_finish(
+                wkObj->longPoll,
+                wkObj->device,
+                doc,
+                currentTime_ms
+            )
+        ), {
+            wkObj->state.pollTimer = currentTime_ms;
+            
+            if (wkObj->hooks.pollStateRespCb != NULL) {
+                wkObj->hooks.pollStateRespCb(wkObj->device, doc);
+            }
+
+            if (wkObj->rpcWorkflow != NULL) {
+                retStatus = polip_rpc_workflow_poll_event(
+                    wkObj->rpcWorkflow, 
+                    wkObj->device, 
+                    doc, 
+                    timestamp
+                );
+            }
+        }, {
+            wkObj->state.pollTimer = currentTime_ms; // Wait expired without change
+        }, wkObj,doc, eventCount, true, POLIP_WORKFLOW_POLL_STATE, retStatus
     );
 
     // Push state to server
     WORKFLOW_EVENT_TEMPLATE(
         (
-            wkObj->flags.stateChanged 
+            !wkObj->params.combinedExchange && wkObj->flags.stateChanged 
         ), {
             if (wkObj->hooks.pushStateSetupCb != NULL) {
                 wkObj->hooks.pushStateSetupCb(wkObj->device, doc);
@@ -122,13 +280,13 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
             if (wkObj->hooks.pushStateRespCb != NULL) {
                 wkObj->hooks.pushStateRespCb(wkObj->device, doc);
             }
-        }, wkObj,doc, eventCount, true, POLIP_WORKFLOW_PUSH_STATE, retStatus
+        }, {}, wkObj,doc, eventCount, true, POLIP_WORKFLOW_PUSH_STATE, retStatus
     );
 
     // Poll server for state changes
     WORKFLOW_EVENT_TEMPLATE(
         (
-            !wkObj->flags.stateChanged && ((currentTime_ms - wkObj->state.pollTimer) >= wkObj->params.pollStateTimeThreshold) 
+            !wkObj->params.combinedExchange && !longPolling && !wkObj->flags.stateChanged && ((currentTime_ms - wkObj->state.pollTimer) >= pollThreshold) 
         ), {}, (
             polip_getState(
                 wkObj->device,
@@ -153,13 +311,15 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
                     timestamp
                 );
             }
+        }, {
+            wkObj->state.pollTimer = currentTime_ms; // Nothing changed, skip response handling
         }, wkObj,doc, eventCount, true, POLIP_WORKFLOW_POLL_STATE, retStatus
     );
 
     // Push sensor state to server
     WORKFLOW_EVENT_TEMPLATE(
-        (wkObj->flags.senseChanged || (wkObj->params.pushSensePeriodic &&
-            (currentTime_ms - wkObj->state.senseTimer) >= wkObj->params.pushSenseTimeThreshold)
+        (!wkObj->params.combinedExchange && (wkObj->flags.senseChanged || (wkObj->params.pushSensePeriodic &&
+            (currentTime_ms - wkObj->state.senseTimer) >= wkObj->params.pushSenseTimeThreshold))
         ), {
             if (wkObj->hooks.pushSenseSetupCb != NULL) {
                 wkObj->hooks.pushSenseSetupCb(wkObj->device, doc);
@@ -175,7 +335,7 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
             if (wkObj->hooks.pushSenseRespCb != NULL) {
                 wkObj->hooks.pushSenseRespCb(wkObj->device, doc);
             }
-        },
+        }, {},
         wkObj,doc, eventCount, true, POLIP_WORKFLOW_PUSH_SENSE, retStatus
     );
 
@@ -195,8 +355,81 @@ polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj,
             if (wkObj->hooks.valueRespCb != NULL) {
                 wkObj->hooks.valueRespCb(wkObj->device, doc);
             }
-        }, wkObj,doc, eventCount, false, POLIP_WORKFLOW_GET_VALUE, retStatus
+        }, {}, wkObj,doc, eventCount, false, POLIP_WORKFLOW_GET_VALUE, retStatus
     );
 
+    // Re-arm long-poll last so it never delays events of this update
+    if (wkObj->longPoll != NULL && !wkObj->flags.getValue && polip_longpoll_due(wkObj->longPoll, currentTime_ms)) {
+        polip_longpoll_start(
+            wkObj->longPoll,
+            wkObj->device,
+            doc,
+            timestamp,
+            currentTime_ms,
+            wkObj->params.pollState,
+            wkObj->params.pollManufacturer,
+            (wkObj->rpcWorkflow != NULL)
+        );
+    }
+
     return retStatus;
+}
+
+polip_ret_code_t polip_workflow_metrics_snapshot(polip_workflow_t* wkObj, JsonObject obj) {
+    if (wkObj->metrics == NULL) {
+        return POLIP_ERROR_WORKFLOW;
+    }
+
+    polip_workflow_metrics_t* metrics = wkObj->metrics;
+    obj["resyncs"] = metrics->valueResyncs;
+    if (wkObj->device != NULL) {
+        obj["replays"] = wkObj->device->valueResyncs;
+    }
+
+    // Per source: outcome counts indexed by polip_ret_code_t (trailing zeros 
+    //  trimmed) and [count, min, mean, max] duration, only for sources seen
+    JsonObject eventsObj = obj.createNestedObject("events");
+    JsonObject durationsObj = obj.createNestedObject("durations");
+    for (int s = 0; s < _POLIP_WORKFLOW_SOURCE_COUNT; s++) {
+        polip_stat_t* duration = &metrics->durations[s];
+        if (duration->count == 0) {
+            continue;
+        }
+
+        int last = _POLIP_RET_CODE_COUNT - 1;
+        while (last > 0 && metrics->events[s][last] == 0) {
+            last--;
+        }
+
+        JsonArray countsArr = eventsObj.createNestedArray(_sourceNames[s]);
+        for (int c = 0; c <= last; c++) {
+            countsArr.add(metrics->events[s][c]);
+        }
+
+        JsonArray durationArr = durationsObj.createNestedArray(_sourceNames[s]);
+        durationArr.add(duration->count);
+        durationArr.add(duration->min);
+        durationArr.add(polip_stat_mean(duration));
+        durationArr.add(duration->max);
+    }
+
+    if (wkObj->rpcWorkflow != NULL && wkObj->rpcWorkflow->metrics != NULL) {
+        polip_rpc_workflow_metrics_snapshot(wkObj->rpcWorkflow, obj.createNestedObject("rpc"));
+    }
+
+    return POLIP_OK;
+}
+
+//==============================================================================
+//  Private Function Implementation
+//==============================================================================
+
+static void _recordEvent(polip_workflow_t* wkObj, polip_workflow_source_t source, 
+        polip_ret_code_t code, unsigned long duration_us) {
+    if (wkObj->metrics == NULL || source >= _POLIP_WORKFLOW_SOURCE_COUNT) {
+        return;
+    }
+
+    wkObj->metrics->events[source][(code < _POLIP_RET_CODE_COUNT) ? code : POLIP_ERROR_WORKFLOW]++;
+    polip_stat_record(&wkObj->metrics->durations[source], duration_us);
 }
\ No newline at end of file
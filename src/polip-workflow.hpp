@@ -22,7 +22,10 @@
 
 #include "./polip-core.hpp"
 #include "./polip-device.hpp"
+#include "./polip-longpoll.hpp"
+#include "./polip-notify.hpp"
 #include "./polip-rpc-workflow.hpp"
+#include "./polip-stats.hpp"
 
 //==============================================================================
 //  Preprocessor Constants
@@ -64,6 +67,15 @@
 //  Public Data Structure Declaration
 //==============================================================================
 
+/**
+ * Fixed memory metrics for workflow events, linked by application
+ */
+typedef struct _polip_workflow_metrics {
+    uint32_t events[_POLIP_WORKFLOW_SOURCE_COUNT][_POLIP_RET_CODE_COUNT] = {{0}}; //! Outcomes per event source
+    polip_stat_t durations[_POLIP_WORKFLOW_SOURCE_COUNT]; //! Event time (us) min / mean / max
+    uint32_t valueResyncs = 0;          //! Value resyncs scheduled for next update
+} polip_workflow_metrics_t;
+
 /**
  * Object used within workflow routine for general update / behavior of polip
  * device.
@@ -79,6 +91,21 @@ typedef struct _polip_workflow {
      * Pointer to RPC workflow
      */
     struct _polip_rpc_workflow * rpcWorkflow = NULL;
+
+    /**
+     * Optional pointer to metrics storage, NULL disables metrics
+     */
+    struct _polip_workflow_metrics * metrics = NULL;
+
+    /**
+     * Optional pointer to push channel, NULL polls on timer only
+     */
+    struct _polip_notify * notify = NULL;
+
+    /**
+     * Optional pointer to long-poll, replaces timed polling while in flight
+     */
+    struct _polip_longpoll * longPoll = NULL;
     
     /**
      * Inner table for parameters used during workflow
@@ -86,9 +113,11 @@ typedef struct _polip_workflow {
      */
     struct _polip_workflow_params {
         bool onlyOneEvent = false;       //! Prevents >1 events ran in 1 update call
+        uint8_t maxEventsPerUpdate = 0;  //! Hard cap on events ran in 1 update call, 0 for none
         bool pushSensePeriodic = false;  //! Flag vs. periodic loop
         bool pollState = true;           //! Allows override of check state during poll
         bool pollManufacturer = false;   //! Checks manufacturer defined data while polling
+        bool combinedExchange = false;   //! Sends due state, poll, sense as one request
         unsigned long pollStateTimeThreshold = POLIP_DEFAULT_POLL_STATE_TIME_THRESHOLD;
         unsigned long pushSenseTimeThreshold = POLIP_DEFAULT_PUSH_SENSE_TIME_THRESHOLD;
     } params;
@@ -125,6 +154,7 @@ typedef struct _polip_workflow {
     struct _polip_workflow_state {
         unsigned long pollTimer = 0;      //! last poll event (ms)
         unsigned long senseTimer = 0;     //! last sense event (ms)
+        polip_ret_code_t lastError = POLIP_OK; //! Error of latest update call, OK if none
     } state;
 
 } polip_workflow_t;
@@ -161,6 +191,15 @@ polip_ret_code_t polip_workflow_teardown(polip_workflow_t* wkObj);
  */
 polip_ret_code_t polip_workflow_periodic_update(polip_workflow_t* wkObj, 
         JsonDocument& doc, const char* timestamp, unsigned long currentTime_ms);
+/**
+ * @brief Writes workflow (and RPC workflow if linked) metrics into a JSON 
+ * object, for example a nested object within sense before pushing
+ * 
+ * @param wkObj workflow object with metrics linked
+ * @param obj JSON object to fill
+ * @return polip_ret_code_t WORKFLOW if metrics not linked; OK on success
+ */
+polip_ret_code_t polip_workflow_metrics_snapshot(polip_workflow_t* wkObj, JsonObject obj);
 
 //==============================================================================
 